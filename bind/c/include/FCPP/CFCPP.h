@@ -53,6 +53,26 @@ struct fcpp_sample_buffer
     void* data;
 };
 
+struct fcpp_perf_counters
+{
+    uint64_t instructions;
+    uint64_t cycles;
+    uint64_t ram_accesses;
+    uint64_t ppu_register_accesses;
+    uint64_t apu_register_accesses;
+    uint64_t prg_accesses;
+    uint64_t chr_accesses;
+    uint64_t vram_accesses;
+    uint64_t mapper_syncs;
+    uint64_t dma_cycles;
+    uint64_t nmis;
+    uint64_t irqs;
+    double cpu_time;
+    double ppu_time;
+    double apu_time;
+    double output_time;
+};
+
 CFCPP_API fcpp_fc_t fcpp_fc_create(void) CFCPP_NOEXCEPT;
 CFCPP_API void fcpp_fc_destroy(fcpp_fc_t fc) CFCPP_NOEXCEPT;
 CFCPP_API int fcpp_fc_insert_cartridge_from_file(fcpp_fc_t fc, const char* path) CFCPP_NOEXCEPT;
@@ -67,6 +87,12 @@ CFCPP_API void fcpp_fc_reset(fcpp_fc_t fc) CFCPP_NOEXCEPT;
 CFCPP_API void fcpp_fc_save(fcpp_fc_t fc, fcpp_snapshot_t snapshot) CFCPP_NOEXCEPT;
 CFCPP_API void fcpp_fc_load(fcpp_fc_t fc, fcpp_snapshot_t snapshot) CFCPP_NOEXCEPT;
 CFCPP_API void fcpp_fc_exec(fcpp_fc_t fc) CFCPP_NOEXCEPT;
+CFCPP_API void fcpp_fc_set_frame_hash(fcpp_fc_t fc, int enable) CFCPP_NOEXCEPT;
+CFCPP_API uint64_t fcpp_fc_get_frame_hash(fcpp_fc_t fc) CFCPP_NOEXCEPT;
+CFCPP_API uint64_t fcpp_fc_get_state_hash(fcpp_fc_t fc) CFCPP_NOEXCEPT;
+/* returns 0 and zero counters if the core is built without FCPP_ENABLE_PROFILER */
+CFCPP_API int fcpp_fc_get_perf_counters(fcpp_fc_t fc, struct fcpp_perf_counters* counters) CFCPP_NOEXCEPT;
+CFCPP_API void fcpp_fc_reset_perf_counters(fcpp_fc_t fc) CFCPP_NOEXCEPT;
 
 CFCPP_API fcpp_ines_t fcpp_ines_create(void) CFCPP_NOEXCEPT;
 CFCPP_API fcpp_ines_t fcpp_ines_create_from(fcpp_ines_t other) CFCPP_NOEXCEPT;
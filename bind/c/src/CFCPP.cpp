@@ -162,6 +162,33 @@ void fcpp_fc_exec(const fcpp_fc_t fc) CFCPP_NOEXCEPT
 {
     fc->self.exec();
 }
+void fcpp_fc_set_frame_hash(const fcpp_fc_t fc, const int enable) CFCPP_NOEXCEPT
+{
+    fc->self.setFrameHash(enable);
+}
+uint64_t fcpp_fc_get_frame_hash(const fcpp_fc_t fc) CFCPP_NOEXCEPT
+{
+    return fc->self.getFrameHash();
+}
+uint64_t fcpp_fc_get_state_hash(const fcpp_fc_t fc) CFCPP_NOEXCEPT
+{
+    return fc->self.getStateHash();
+}
+int fcpp_fc_get_perf_counters(const fcpp_fc_t fc, fcpp_perf_counters* const counters) CFCPP_NOEXCEPT
+{
+    auto c = fc->self.getProfiler()->get();
+    *counters = {
+        c.instructions, c.cycles,
+        c.ramAccesses, c.ppuRegisterAccesses, c.apuRegisterAccesses, c.prgAccesses, c.chrAccesses, c.vramAccesses,
+        c.mapperSyncs, c.dmaCycles, c.nmis, c.irqs,
+        c.cpuTime, c.ppuTime, c.apuTime, c.outputTime
+    };
+    return fcpp::core::Profiler::Enabled;
+}
+void fcpp_fc_reset_perf_counters(const fcpp_fc_t fc) CFCPP_NOEXCEPT
+{
+    fc->self.getProfiler()->reset();
+}
 
 fcpp_ines_t fcpp_ines_create(void) CFCPP_NOEXCEPT
 {
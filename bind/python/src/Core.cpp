@@ -178,6 +178,30 @@ void initCoreModule(py::module_& m)
         .def("send_sample", &fcpp::core::SampleBuffer::sendSample)
         .def("get_sample_rate", &fcpp::core::SampleBuffer::getSampleRate);
 
+    auto profiler =
+        py::class_<fcpp::core::Profiler>(m, "Profiler")
+        .def("get", &fcpp::core::Profiler::get)
+        .def("reset", &fcpp::core::Profiler::reset)
+        .def_readonly_static("ENABLED", &fcpp::core::Profiler::Enabled);
+
+    py::class_<fcpp::core::Profiler::Counters>(profiler, "Counters")
+        .def_readonly("instructions", &fcpp::core::Profiler::Counters::instructions)
+        .def_readonly("cycles", &fcpp::core::Profiler::Counters::cycles)
+        .def_readonly("ram_accesses", &fcpp::core::Profiler::Counters::ramAccesses)
+        .def_readonly("ppu_register_accesses", &fcpp::core::Profiler::Counters::ppuRegisterAccesses)
+        .def_readonly("apu_register_accesses", &fcpp::core::Profiler::Counters::apuRegisterAccesses)
+        .def_readonly("prg_accesses", &fcpp::core::Profiler::Counters::prgAccesses)
+        .def_readonly("chr_accesses", &fcpp::core::Profiler::Counters::chrAccesses)
+        .def_readonly("vram_accesses", &fcpp::core::Profiler::Counters::vramAccesses)
+        .def_readonly("mapper_syncs", &fcpp::core::Profiler::Counters::mapperSyncs)
+        .def_readonly("dma_cycles", &fcpp::core::Profiler::Counters::dmaCycles)
+        .def_readonly("nmis", &fcpp::core::Profiler::Counters::nmis)
+        .def_readonly("irqs", &fcpp::core::Profiler::Counters::irqs)
+        .def_readonly("cpu_time", &fcpp::core::Profiler::Counters::cpuTime)
+        .def_readonly("ppu_time", &fcpp::core::Profiler::Counters::ppuTime)
+        .def_readonly("apu_time", &fcpp::core::Profiler::Counters::apuTime)
+        .def_readonly("output_time", &fcpp::core::Profiler::Counters::outputTime);
+
     py::class_<fcpp::core::FC>(m, "FC")
         .def(py::init())
         .def("insert_cartridge", py::overload_cast<const char*>(&fcpp::core::FC::insertCartridge), py::arg("path"))
@@ -191,7 +215,11 @@ void initCoreModule(py::module_& m)
         .def("reset", &fcpp::core::FC::reset)
         .def("save", &fcpp::core::FC::save, py::arg("snapshot"))
         .def("load", &fcpp::core::FC::load, py::arg("snapshot"))
-        .def("exec", &fcpp::core::FC::exec);
+        .def("exec", &fcpp::core::FC::exec)
+        .def("set_frame_hash", &fcpp::core::FC::setFrameHash, py::arg("enable"))
+        .def("get_frame_hash", &fcpp::core::FC::getFrameHash)
+        .def("get_state_hash", &fcpp::core::FC::getStateHash)
+        .def("get_profiler", &fcpp::core::FC::getProfiler, py::return_value_policy::reference_internal);
 
     py::class_<fcpp::core::INES>(m, "INES")
         .def(py::init())
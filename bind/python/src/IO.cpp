@@ -1,7 +1,9 @@
 #include <tuple>
+#include <vector>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/functional.h>
+#include <pybind11/stl.h>
 
 #include "FCPP/IO.hpp"
 
@@ -27,14 +29,19 @@ public:
     fcpp::core::InputScanner* getInputScanner(int idx) noexcept override;
     fcpp::core::SampleBuffer* getSampleBuffer() noexcept override;
     void render() noexcept override;
+    void setPresentThread(bool enable) noexcept override;
     bool setFullScreen(bool enable) noexcept override;
     bool setBorderless(bool enable) noexcept override;
     bool setVerticalSync(bool enable) noexcept override;
     bool setRenderDriver(int idx) noexcept override;
     bool setJoystickPort(int idx, int port) noexcept override;
     void setScale(float factor) noexcept override;
+    void setVideoFilter(fcpp::io::VideoFilter::Type type, int scale, int threads) override;
     void setTitle(const char* text) noexcept override;
     void setFPSLimit(double fps) noexcept override;
+    void setAudioSync(bool enable) noexcept override;
+    PacingStats getPacingStats() noexcept override;
+    void setOverlay(const float* values, int count) noexcept override;
     void setVolume(float volume) noexcept override;
     void setSampleRate(int rate) noexcept override;
     void setJoypadType(int idx, fcpp::core::JoypadType type) noexcept override;
@@ -96,6 +103,16 @@ void PyController::render() noexcept
         render
     );
 }
+void PyController::setPresentThread(const bool enable) noexcept
+{
+    PYBIND11_OVERLOAD_PURE_NAME(
+        void,
+        Controller,
+        "set_present_thread",
+        setPresentThread,
+        enable
+    );
+}
 bool PyController::setFullScreen(const bool enable) noexcept
 {
     PYBIND11_OVERLOAD_PURE_NAME(
@@ -156,6 +173,16 @@ void PyController::setScale(const float factor) noexcept
         factor
     );
 }
+void PyController::setVideoFilter(const fcpp::io::VideoFilter::Type type, const int scale, const int threads)
+{
+    PYBIND11_OVERLOAD_PURE_NAME(
+        void,
+        Controller,
+        "set_video_filter",
+        setVideoFilter,
+        type, scale, threads
+    );
+}
 void PyController::setTitle(const char* const text) noexcept
 {
     PYBIND11_OVERLOAD_PURE_NAME(
@@ -176,6 +203,35 @@ void PyController::setFPSLimit(const double fps) noexcept
         fps
     );
 }
+void PyController::setAudioSync(const bool enable) noexcept
+{
+    PYBIND11_OVERLOAD_PURE_NAME(
+        void,
+        Controller,
+        "set_audio_sync",
+        setAudioSync,
+        enable
+    );
+}
+fcpp::io::Controller::PacingStats PyController::getPacingStats() noexcept
+{
+    PYBIND11_OVERLOAD_PURE_NAME(
+        PacingStats,
+        Controller,
+        "get_pacing_stats",
+        getPacingStats
+    );
+}
+void PyController::setOverlay(const float* const values, const int count) noexcept
+{
+    PYBIND11_OVERLOAD_PURE_NAME(
+        void,
+        Controller,
+        "set_overlay",
+        setOverlay,
+        std::vector<float>(values, values + (count > 0 ? count : 0))
+    );
+}
 void PyController::setVolume(const float volume) noexcept
 {
     PYBIND11_OVERLOAD_PURE_NAME(
@@ -453,6 +509,12 @@ void initIOModule(py::module_& m)
         .value("Axis4P", fcpp::io::Joystick::Axis4P)
         .value("Axis5P", fcpp::io::Joystick::Axis5P);
 
+    py::enum_<fcpp::io::VideoFilter::Type>(m, "VideoFilterType")
+        .value("Off", fcpp::io::VideoFilter::Type::None)
+        .value("Nearest", fcpp::io::VideoFilter::Type::Nearest)
+        .value("Scale2x", fcpp::io::VideoFilter::Type::Scale2x)
+        .value("NTSC", fcpp::io::VideoFilter::Type::NTSC);
+
     auto paletteColorGetter = 
         [](fcpp::io::PaletteTable& object, const int idx) -> std::tuple<std::uint8_t, std::uint8_t, std::uint8_t> {
             std::uint8_t r = 0, g = 0, b = 0;
@@ -483,14 +545,21 @@ void initIOModule(py::module_& m)
         .def("get_input_scanner", &fcpp::io::Controller::getInputScanner, py::return_value_policy::reference_internal)
         .def("get_sample_buffer", &fcpp::io::Controller::getSampleBuffer, py::return_value_policy::reference_internal)
         .def("render", &fcpp::io::Controller::render)
+        .def("set_present_thread", &fcpp::io::Controller::setPresentThread)
         .def("set_full_screen", &fcpp::io::Controller::setFullScreen)
         .def("set_borderless", &fcpp::io::Controller::setBorderless)
         .def("set_vertical_sync", &fcpp::io::Controller::setVerticalSync)
         .def("set_render_driver", &fcpp::io::Controller::setRenderDriver)
         .def("set_joystick_port", &fcpp::io::Controller::setJoystickPort)
         .def("set_scale", &fcpp::io::Controller::setScale)
+        .def("set_video_filter", &fcpp::io::Controller::setVideoFilter, py::arg("type"), py::arg("scale"), py::arg("threads") = 1)
         .def("set_title", &fcpp::io::Controller::setTitle)
         .def("set_fps_limit", &fcpp::io::Controller::setFPSLimit)
+        .def("set_audio_sync", &fcpp::io::Controller::setAudioSync)
+        .def("get_pacing_stats", &fcpp::io::Controller::getPacingStats)
+        .def("set_overlay", [](fcpp::io::Controller& object, const std::vector<float>& values) {
+                object.setOverlay(values.data(), static_cast<int>(values.size()));
+            })
         .def("set_volume", &fcpp::io::Controller::setVolume)
         .def("set_sample_rate", &fcpp::io::Controller::setSampleRate)
         .def("set_joypad_type", &fcpp::io::Controller::setJoypadType)
@@ -507,4 +576,12 @@ void initIOModule(py::module_& m)
         .def(py::init())
         .def("get_render_driver_count", &fcpp::io::Controller::Info::getRenderDriverCount)
         .def("get_render_driver_name", &fcpp::io::Controller::Info::getRenderDriverName);
+
+    py::class_<fcpp::io::Controller::PacingStats>(controller, "PacingStats")
+        .def(py::init())
+        .def_readwrite("frames", &fcpp::io::Controller::PacingStats::frames)
+        .def_readwrite("missed", &fcpp::io::Controller::PacingStats::missed)
+        .def_readwrite("mean_frame_time", &fcpp::io::Controller::PacingStats::meanFrameTime)
+        .def_readwrite("jitter", &fcpp::io::Controller::PacingStats::jitter)
+        .def_readwrite("max_lateness", &fcpp::io::Controller::PacingStats::maxLateness);
 }
@@ -7,13 +7,34 @@ struct Options
     bool showUsage = false;
     bool showVersion = false;
     bool listEngine = false;
+    bool runAheadSecondInstance = false;
+    bool presentThread = false;
+    bool renderThread = false;
+    bool audioSync = false;
+    bool pacingStats = false;
+    bool profile = false;
     int engineIndex = 0;
     int rendererIndex = 0;
+    int runAheadFrames = 0;
+    int videoFilterScale = 4;
+    int videoFilterThreads = 1;
+    int recordEvery = 1;
+    unsigned long long frames = 0;
     std::string romPath{};
+    std::string videoFilter{};
+    std::string videoDumpPath{};
+    std::string audioDumpPath{};
+    std::string inputScriptPath{};
+    std::string recordVideoPath{};
+    std::string recordAudioPath{};
+    std::string recordMoviePath{};
+    std::string tracePath{};
 
     enum class ArgType
     {
-        ShowUsage, ShowVersion, ListEngine, EngineIndex, RendererIndex
+        ShowUsage, ShowVersion, ListEngine, EngineIndex, RendererIndex, RunAheadFrames, RunAheadSecondInstance, PresentThread,
+        RenderThread, AudioSync, PacingStats, Profile, Frames, VideoFilter, VideoFilterScale, VideoFilterThreads,
+        VideoDump, AudioDump, InputScript, RecordVideo, RecordAudio, RecordEvery, RecordMovie, Trace
     };
 
     struct Arg
@@ -29,6 +50,25 @@ struct Options
         {"--list_engine", {ArgType::ListEngine, "List engines and renderers"}},
         {"--engine_index", {ArgType::EngineIndex, "Set engine by index"}},
         {"--renderer_index", {ArgType::RendererIndex, "Set renderer by index"}},
+        {"--run_ahead", {ArgType::RunAheadFrames, "Set frames to run ahead for lower input latency (0-8)"}},
+        {"--run_ahead_second_instance", {ArgType::RunAheadSecondInstance, "Run ahead on a second instance to keep audio intact"}},
+        {"--present_thread", {ArgType::PresentThread, "Present frames on a separate thread so emulation never waits for vsync, ignored on macOS"}},
+        {"--render_thread", {ArgType::RenderThread, "Draw frames on a second thread while the emulation thread keeps the timing"}},
+        {"--audio_sync", {ArgType::AudioSync, "Pace frames from the audio buffer to avoid audio underruns, best with vsync off"}},
+        {"--pacing_stats", {ArgType::PacingStats, "Print frame pacing statistics on exit"}},
+        {"--profile", {ArgType::Profile, "Show the CPU, PPU, APU and output load as bars and print performance counters on exit, needs FCPP_ENABLE_PROFILER"}},
+        {"--frames", {ArgType::Frames, "Exit after running n frames"}},
+        {"--video_filter", {ArgType::VideoFilter, "Post-process frames on the CPU with none, nearest, scale2x or ntsc, also applied to video dumps"}},
+        {"--video_filter_scale", {ArgType::VideoFilterScale, "Set the output scale of the video filter (1-4, default 4)"}},
+        {"--video_filter_threads", {ArgType::VideoFilterThreads, "Set threads of the video filter, 0 for one per hardware thread (default 1)"}},
+        {"--dump_video", {ArgType::VideoDump, "Write raw 32-bit ARGB frames to a file (Null engine only)"}},
+        {"--dump_audio", {ArgType::AudioDump, "Write raw 16-bit mono samples to a file (Null engine only)"}},
+        {"--input_script", {ArgType::InputScript, "Read joypad input from a script file (Null engine only)"}},
+        {"--record_video", {ArgType::RecordVideo, "Record video on a writer thread, Y4M if the file name ends with .y4m, raw 24-bit RGB otherwise"}},
+        {"--record_audio", {ArgType::RecordAudio, "Record audio on a writer thread to a 16-bit mono WAV file"}},
+        {"--record_every", {ArgType::RecordEvery, "Record every n-th frame only (default 1)"}},
+        {"--record_movie", {ArgType::RecordMovie, "Record joypad input to a movie file for fcpp_movie_player, not with --run_ahead, needs FCPP_BUILD_TOOLS"}},
+        {"--trace", {ArgType::Trace, "Write a Chrome trace JSON timeline of frames, presenting and audio to a file on exit"}},
     };
 
     std::string usage()
@@ -68,6 +108,63 @@ struct Options
             case ArgType::RendererIndex:
                 if (i + 1 < argc) rendererIndex = std::atoi(argv[++i]);
                 break;
+            case ArgType::RunAheadFrames:
+                if (i + 1 < argc) runAheadFrames = std::atoi(argv[++i]);
+                break;
+            case ArgType::RunAheadSecondInstance:
+                runAheadSecondInstance = true;
+                break;
+            case ArgType::PresentThread:
+                presentThread = true;
+                break;
+            case ArgType::RenderThread:
+                renderThread = true;
+                break;
+            case ArgType::AudioSync:
+                audioSync = true;
+                break;
+            case ArgType::PacingStats:
+                pacingStats = true;
+                break;
+            case ArgType::Profile:
+                profile = true;
+                break;
+            case ArgType::Frames:
+                if (i + 1 < argc) frames = std::strtoull(argv[++i], nullptr, 10);
+                break;
+            case ArgType::VideoFilter:
+                if (i + 1 < argc) videoFilter = argv[++i];
+                break;
+            case ArgType::VideoFilterScale:
+                if (i + 1 < argc) videoFilterScale = std::atoi(argv[++i]);
+                break;
+            case ArgType::VideoFilterThreads:
+                if (i + 1 < argc) videoFilterThreads = std::atoi(argv[++i]);
+                break;
+            case ArgType::VideoDump:
+                if (i + 1 < argc) videoDumpPath = argv[++i];
+                break;
+            case ArgType::AudioDump:
+                if (i + 1 < argc) audioDumpPath = argv[++i];
+                break;
+            case ArgType::InputScript:
+                if (i + 1 < argc) inputScriptPath = argv[++i];
+                break;
+            case ArgType::RecordVideo:
+                if (i + 1 < argc) recordVideoPath = argv[++i];
+                break;
+            case ArgType::RecordAudio:
+                if (i + 1 < argc) recordAudioPath = argv[++i];
+                break;
+            case ArgType::RecordEvery:
+                if (i + 1 < argc) recordEvery = std::atoi(argv[++i]);
+                break;
+            case ArgType::RecordMovie:
+                if (i + 1 < argc) recordMoviePath = argv[++i];
+                break;
+            case ArgType::Trace:
+                if (i + 1 < argc) tracePath = argv[++i];
+                break;
             }
         }
     }
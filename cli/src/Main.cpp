@@ -1,10 +1,18 @@
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <iostream>
 
 #include "FCPP/Core.hpp"
 #include "FCPP/IO.hpp"
 #include "FCPP/Util/Archive.hpp"
+#include "FCPP/Util/Trace.hpp"
+#ifdef TFCPP_WITH_TOOLS
+#   include "FCPP/Tools/Movie.hpp"
+#endif
 
 #include "Options.hpp"
 
@@ -57,6 +65,21 @@ int main(int argc, char* argv[])
         return 0;
     }
 
+    if (!options.recordMoviePath.empty())
+    {
+#ifdef TFCPP_WITH_TOOLS
+        // run-ahead replays frames, which the movie would record twice
+        if (options.runAheadFrames > 0)
+        {
+            std::cerr << "Movie recording does not work with run-ahead" << std::endl;
+            return 0;
+        }
+#else
+        std::cerr << "Movie recording is not built in, rebuild with FCPP_BUILD_TOOLS" << std::endl;
+        return 0;
+#endif
+    }
+
     std::string fileName{};
     if (auto pos = options.romPath.find_last_of("/\\"); pos == std::string::npos) fileName = options.romPath;
     else fileName = options.romPath.substr(pos + 1);
@@ -71,16 +94,71 @@ int main(int argc, char* argv[])
         return 0;
     }
 
+    if (!std::strcmp(fcpp::io::manager::name(options.engineIndex), "Null"))
+    {
+        auto null = static_cast<fcpp::io::NullController*>(controller.get());
+        if ((!options.videoDumpPath.empty() && !null->setVideoDump(options.videoDumpPath.c_str())) ||
+            (!options.audioDumpPath.empty() && !null->setAudioDump(options.audioDumpPath.c_str())) ||
+            (!options.inputScriptPath.empty() && !null->setInputScript(options.inputScriptPath.c_str())))
+        {
+            std::cerr << "Failed to set up Null engine" << std::endl;
+            return 0;
+        }
+    }
+
+    if (!options.videoFilter.empty())
+    {
+        fcpp::io::VideoFilter::Type filter{};
+        if (options.videoFilter == "none") filter = fcpp::io::VideoFilter::Type::None;
+        else if (options.videoFilter == "nearest") filter = fcpp::io::VideoFilter::Type::Nearest;
+        else if (options.videoFilter == "scale2x") filter = fcpp::io::VideoFilter::Type::Scale2x;
+        else if (options.videoFilter == "ntsc") filter = fcpp::io::VideoFilter::Type::NTSC;
+        else
+        {
+            std::cerr << "Unknown video filter: " << options.videoFilter << std::endl;
+            return 0;
+        }
+        controller->setVideoFilter(filter, options.videoFilterScale, options.videoFilterThreads);
+    }
+
     controller->setTitle(fileName.c_str());
     controller->setScale(2.0f);
     controller->setVerticalSync(true);
+    controller->setPresentThread(options.presentThread);
+    controller->setAudioSync(options.audioSync);
 
     auto info = fcpp::io::manager::info(options.engineIndex);
     options.rendererIndex = std::clamp(options.rendererIndex, 0, info->getRenderDriverCount() - 1);
     controller->setRenderDriver(options.rendererIndex);
 
-    bool stopFlag = false, pauseFlag = false, resetFlag = false, saveFlag = false, loadFlag = false;
+    // written by the callbacks, which run on the present thread if enabled
+    std::atomic<bool> stopFlag = false, pauseFlag = false, resetFlag = false, saveFlag = false, loadFlag = false;
     controller->setCloseCallback([&]() {stopFlag = true; });
+    bool frameFlag = false;
+    unsigned long long frames = 0;
+    auto profiler = fc.getProfiler();
+    auto profileTime = std::chrono::steady_clock::now();
+    auto profileCounters = profiler->get();
+    controller->setRenderCallback([&]()
+        {
+            frameFlag = true;
+            if (++frames == options.frames) stopFlag = true;
+            if (!options.profile || !fcpp::core::Profiler::Enabled || frames % 60) return;
+
+            // load of each part over the last 60 frames
+            auto now = std::chrono::steady_clock::now();
+            auto counters = profiler->get();
+            auto elapsed = std::chrono::duration<double>{ now - profileTime }.count();
+            float load[] = {
+                static_cast<float>((counters.cpuTime - profileCounters.cpuTime) / elapsed),
+                static_cast<float>((counters.ppuTime - profileCounters.ppuTime) / elapsed),
+                static_cast<float>((counters.apuTime - profileCounters.apuTime) / elapsed),
+                static_cast<float>((counters.outputTime - profileCounters.outputTime) / elapsed)
+            };
+            controller->setOverlay(load, static_cast<int>(sizeof(load) / sizeof(*load)));
+            profileTime = now;
+            profileCounters = counters;
+        });
     controller->setKeyPressCallback([&](const fcpp::io::Keyboard key)
         {
             switch (key)
@@ -113,11 +191,53 @@ int main(int argc, char* argv[])
 
     fcpp::core::Snapshot snapshot{};
 
+    std::unique_ptr<fcpp::core::RunAhead> runAhead{};
+    std::unique_ptr<fcpp::io::Recorder> recorder{};
+#ifdef TFCPP_WITH_TOOLS
+    fcpp::tools::Movie movie{};
+    std::unique_ptr<fcpp::tools::MovieRecorder> movieRecorder{};
+#endif
+
+    auto frameBuffer = controller->getFrameBuffer();
+    auto sampleBuffer = controller->getSampleBuffer();
+    if (!options.recordVideoPath.empty() || !options.recordAudioPath.empty())
+    {
+        recorder = std::make_unique<fcpp::io::Recorder>();
+        frameBuffer = recorder->tap(frameBuffer);
+        sampleBuffer = recorder->tap(sampleBuffer);
+        // without a window nothing has to keep real time, so every frame is written
+        recorder->setBlocking(!std::strcmp(fcpp::io::manager::name(options.engineIndex), "Null"));
+    }
+
     fc.connect(0, controller->getInputScanner(0));
     fc.connect(1, controller->getInputScanner(1));
-    fc.connect(controller->getFrameBuffer());
-    fc.connect(controller->getSampleBuffer());
+    if (options.runAheadFrames > 0)
+    {
+        runAhead = std::make_unique<fcpp::core::RunAhead>(&fc);
+        runAhead->connect(frameBuffer);
+        runAhead->connect(sampleBuffer);
+        runAhead->setFrames(options.runAheadFrames);
+    }
+    else
+    {
+        fc.connect(frameBuffer);
+        fc.connect(sampleBuffer);
+    }
+#ifdef TFCPP_WITH_TOOLS
+    if (!options.recordMoviePath.empty())
+    {
+        // takes over the joypads and outputs connected above
+        movieRecorder = std::make_unique<fcpp::tools::MovieRecorder>();
+        movieRecorder->connect(&fc, &movie);
+        movieRecorder->connect(0, controller->getInputScanner(0));
+        movieRecorder->connect(1, controller->getInputScanner(1));
+        movieRecorder->connect(frameBuffer);
+        movieRecorder->connect(sampleBuffer);
+    }
+#endif
     fc.powerOn();
+    if (runAhead) runAhead->setSecondInstance(options.runAheadSecondInstance);
+    fc.setRenderThread(options.renderThread);
 
     if (std::uint64_t size = 0; fcpp::util::archive::load(saveName, fileName, reinterpret_cast<char*>(snapshot.data()), size))
     {
@@ -125,11 +245,42 @@ int main(int argc, char* argv[])
         fc.load(snapshot);
     }
 
+#ifdef TFCPP_WITH_TOOLS
+    // a resumed game is recorded from its saved state
+    if (movieRecorder) movieRecorder->start(snapshot.size() != 0);
+#endif
+    // a movie holds input only, so it ends at a reset or a loaded state
+    auto stopMovie = [&]()
+        {
+#ifdef TFCPP_WITH_TOOLS
+            if (!movieRecorder || !movieRecorder->isRecording()) return;
+            movieRecorder->stop();
+            std::cerr << "Movie recording stopped after " << movie.getFrameCount() << " frames" << std::endl;
+#endif
+        };
+
+    if (recorder)
+    {
+        auto& path = options.recordVideoPath;
+        auto format = path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0 ?
+            fcpp::io::Recorder::VideoFormat::Y4M : fcpp::io::Recorder::VideoFormat::RGB;
+        if (!recorder->start(path.empty() ? nullptr : path.c_str(), format,
+            options.recordAudioPath.empty() ? nullptr : options.recordAudioPath.c_str(), options.recordEvery))
+        {
+            std::cerr << "Failed to open recording files" << std::endl;
+            return 0;
+        }
+    }
+
+    fcpp::util::Trace::setThreadName("emulation");
+    if (!options.tracePath.empty()) fcpp::util::Trace::enable(true);
+
     while (!stopFlag)
     {
         if (resetFlag)
         {
             pauseFlag = resetFlag = false;
+            stopMovie();
             fc.reset();
         }
         else if (saveFlag)
@@ -140,14 +291,77 @@ int main(int argc, char* argv[])
         else if (loadFlag)
         {
             loadFlag = false;
+            stopMovie();
             fc.load(snapshot);
         }
         else if (pauseFlag) controller->render();
-        else fc.exec();
+        else
+        {
+            fcpp::util::Trace::Scope scope{ "frame" };
+            if (runAhead) runAhead->exec();
+            else for (frameFlag = false; !frameFlag;) fc.exec();
+        }
+    }
+
+    if (recorder)
+    {
+        recorder->stop();
+        if (auto dropped = recorder->getDroppedFrames(); dropped)
+            std::cerr << "Recorded " << recorder->getFrameCount() << " frames, dropped " << dropped << std::endl;
+    }
+
+#ifdef TFCPP_WITH_TOOLS
+    if (movieRecorder)
+    {
+        movieRecorder->stop();
+        if (!movie.save(options.recordMoviePath.c_str()))
+            std::cerr << "Failed to write movie file: " << options.recordMoviePath << std::endl;
+    }
+#endif
+
+    if (!options.tracePath.empty())
+    {
+        fcpp::util::Trace::enable(false);
+        if (!fcpp::util::Trace::dump(options.tracePath.c_str()))
+            std::cerr << "Failed to write trace file: " << options.tracePath << std::endl;
     }
 
     fc.save(snapshot);
     fcpp::util::archive::save(saveName, fileName, reinterpret_cast<char*>(snapshot.data()), snapshot.size());
 
+    if (options.pacingStats)
+    {
+        auto stats = controller->getPacingStats();
+        std::cout
+            << "frames: " << stats.frames << " (missed " << stats.missed << ")\n"
+            << "frame time: " << stats.meanFrameTime << " ms (jitter " << stats.jitter << " ms)\n"
+            << "max lateness: " << stats.maxLateness << " ms" << std::endl;
+    }
+
+    if (options.profile)
+    {
+        if constexpr (fcpp::core::Profiler::Enabled)
+        {
+            auto counters = profiler->get();
+            std::cout
+                << "instructions: " << counters.instructions << "\n"
+                << "cycles: " << counters.cycles << "\n"
+                << "ram accesses: " << counters.ramAccesses << "\n"
+                << "ppu register accesses: " << counters.ppuRegisterAccesses << "\n"
+                << "apu register accesses: " << counters.apuRegisterAccesses << "\n"
+                << "prg accesses: " << counters.prgAccesses << "\n"
+                << "chr accesses: " << counters.chrAccesses << "\n"
+                << "vram accesses: " << counters.vramAccesses << "\n"
+                << "mapper syncs: " << counters.mapperSyncs << "\n"
+                << "dma cycles: " << counters.dmaCycles << "\n"
+                << "nmi: " << counters.nmis << " irq: " << counters.irqs << "\n"
+                << "cpu time: " << counters.cpuTime << " s\n"
+                << "ppu time: " << counters.ppuTime << " s\n"
+                << "apu time: " << counters.apuTime << " s\n"
+                << "output time: " << counters.outputTime << " s" << std::endl;
+        }
+        else std::cout << "Profiler is not built in, rebuild with FCPP_ENABLE_PROFILER" << std::endl;
+    }
+
     return 0;
 }
@@ -6,5 +6,7 @@
 #include "FCPP/Core/Interface/SampleBuffer.hpp"
 
 #include "FCPP/Core/FC.hpp"
+#include "FCPP/Core/ROMPack.hpp"
+#include "FCPP/Core/RunAhead.hpp"
 
 #endif
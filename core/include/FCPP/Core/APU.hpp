@@ -17,6 +17,7 @@ private:
     struct APUData;
 public:
     APU();
+    APU(const APU& other);
     ~APU() noexcept;
 
     void connect(void* p) noexcept;
@@ -22,6 +22,7 @@ public:
     };
 public:
     Bus();
+    Bus(const Bus& other);
     ~Bus() noexcept;
 
     void connect(void* p) noexcept;
@@ -34,6 +35,8 @@ public:
     template<typename Accessor>
     FCPP_EXPORT void write(std::uint16_t addr, std::uint8_t data) noexcept;
 
+    // OAM DMA from work RAM as a single copy, false if it has to be done byte by byte
+    bool copyOAM(std::uint16_t src, unsigned int cycles) noexcept;
     template<MemoryType type>
     FCPP_EXPORT const std::uint8_t* dump() const noexcept;
 private:
@@ -40,6 +40,7 @@ private:
     struct CPUData;
 public:
     CPU();
+    CPU(const CPU& other);
     ~CPU() noexcept;
 
     void connect(void* p) noexcept;
@@ -7,6 +7,7 @@
 #include <FCPPExport.hpp>
 
 #include "FCPP/Core/INES.hpp"
+#include "FCPP/Core/Pattern.hpp"
 
 namespace fcpp::core
 {
@@ -21,6 +22,7 @@ public:
     FCPP_EXPORT static bool support(const INES& rom);
 public:
     Cartridge();
+    Cartridge(const Cartridge& other);
     ~Cartridge() noexcept;
 
     void connect(void* p) noexcept;
@@ -39,6 +41,8 @@ public:
 
     std::uint8_t readCHR(std::uint16_t addr) noexcept;
     void writeCHR(std::uint16_t addr, std::uint8_t data) noexcept;
+    // row of the pattern tile at addr on the PPU bus, decoded once until the banks or CHR RAM change
+    FCPP_EXPORT const PatternRow& readPattern(std::uint16_t addr) noexcept;
 
     void sync() noexcept;
 private:
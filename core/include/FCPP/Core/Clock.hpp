@@ -15,6 +15,7 @@ private:
     struct ClockData;
 public:
     Clock();
+    Clock(const Clock& other);
     ~Clock() noexcept;
 
     void connect(void* p) noexcept;
@@ -23,6 +24,7 @@ public:
     void reset() noexcept;
 
     void tick() noexcept;
+    void tick(std::uint32_t cycles) noexcept;
     void setFrameRate(double fps) noexcept;
     std::uint64_t getAPUCycles() noexcept;
     std::uint64_t getCPUCycles() noexcept;
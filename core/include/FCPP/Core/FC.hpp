@@ -1,6 +1,7 @@
 #ifndef FCPP_CORE_FC_HPP
 #define FCPP_CORE_FC_HPP
 
+#include <cstdint>
 #include <memory>
 
 #include <FCPPExport.hpp>
@@ -12,6 +13,7 @@
 #include "FCPP/Core/PPU.hpp"
 #include "FCPP/Core/APU.hpp"
 #include "FCPP/Core/Joypad.hpp"
+#include "FCPP/Core/Profiler.hpp"
 #include "FCPP/Core/Snapshot.hpp"
 
 namespace fcpp::core
@@ -28,6 +30,9 @@ public:
     FCPP_EXPORT FC(FC&&) noexcept;
     FCPP_EXPORT ~FC() noexcept;
 
+    // create an independent copy of the current machine, outputs can be rebound with connect()
+    FCPP_EXPORT FC clone() const;
+
     FCPP_EXPORT bool insertCartridge(const char* path);
     FCPP_EXPORT bool insertCartridge(const INES& content);
     FCPP_EXPORT bool insertCartridge(INES&& content);
@@ -51,6 +56,17 @@ public:
 
     FCPP_EXPORT void exec() noexcept;
 
+    // draw frames on a second thread while this one keeps emulating, the output stays the same
+    FCPP_EXPORT void setRenderThread(bool enable);
+    FCPP_EXPORT bool getRenderThread() const noexcept;
+
+    // hash every frame as it is drawn, no cost while disabled
+    FCPP_EXPORT void setFrameHash(bool enable) noexcept;
+    // hash of the palette indices of the last completed frame, the same for any palette table, 0 if frame hash is disabled
+    FCPP_EXPORT std::uint64_t getFrameHash() const noexcept;
+    // hash of the current machine state, covering everything a snapshot holds
+    FCPP_EXPORT std::uint64_t getStateHash() noexcept;
+
     FCPP_EXPORT Clock* getClock() noexcept;
     FCPP_EXPORT CPU* getCPU() noexcept;
     FCPP_EXPORT PPU* getPPU() noexcept;
@@ -58,6 +74,10 @@ public:
     FCPP_EXPORT Bus* getBus() noexcept;
     FCPP_EXPORT Cartridge* getCartridge() noexcept;
     FCPP_EXPORT Joypad* getJoypad(int idx) noexcept;
+    // counters stay zero unless built with FCPP_ENABLE_PROFILER
+    FCPP_EXPORT Profiler* getProfiler() noexcept;
+private:
+    explicit FC(std::unique_ptr<FCData> data) noexcept;
 private:
     std::unique_ptr<FCData> dptr;
 };
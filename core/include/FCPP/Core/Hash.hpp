@@ -0,0 +1,38 @@
+#ifndef FCPP_CORE_HASH_HPP
+#define FCPP_CORE_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+* 64-bit hashing shared by the frame and state hashes.
+* Movies and regression results store these hashes to compare machines across hosts and builds,
+* so the algorithm is fixed and independent of the host byte order, changing it breaks every stored hash.
+*/
+namespace fcpp::core::detail
+{
+    static constexpr std::uint64_t HashSeed = 0x9e3779b97f4a7c15;
+
+    inline std::uint64_t hashMix(std::uint64_t hash, const std::uint64_t value) noexcept
+    {
+        hash ^= value * 0xbf58476d1ce4e5b9;
+        hash = (hash << 31) | (hash >> 33);
+        return hash * 0x94d049bb133111eb;
+    }
+    inline std::uint64_t hashBlock(const std::uint8_t* const data, const std::size_t size) noexcept
+    {
+        std::uint64_t hash = hashMix(HashSeed, size), value = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            // little-endian words, compilers turn this into a single load on little-endian hosts
+            value = 0;
+            for (std::size_t j = 0; j < 8; j++) value |= static_cast<std::uint64_t>(data[i + j]) << (8 * j);
+            hash = hashMix(hash, value);
+        }
+        for (value = 0; i < size; i++) value = (value << 8) | data[i];
+        return hashMix(hash, value);
+    }
+}
+
+#endif
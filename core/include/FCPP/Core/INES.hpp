@@ -25,6 +25,9 @@ class fcpp::core::INES
 {
 private:
     struct INESData;
+public:
+    // map a file into read-only memory, fall back to reading it at once
+    FCPP_EXPORT static std::shared_ptr<const std::uint8_t> map(const char* path, std::size_t& size);
 public:
     FCPP_EXPORT INES();
     FCPP_EXPORT INES(const INES&);
@@ -34,16 +37,23 @@ public:
     FCPP_EXPORT INES& operator=(INES&&) noexcept;
 
     FCPP_EXPORT bool load(const char* path);
+    // copy rom data from buffer
     FCPP_EXPORT bool load(const std::uint8_t* buffer, std::size_t size) noexcept;
+    // reference rom data in image without copying
+    FCPP_EXPORT bool load(std::shared_ptr<const std::uint8_t> image, std::size_t size) noexcept;
+    // reference a caller-owned buffer, which must outlive this object and all its copies
+    FCPP_EXPORT bool loadView(const std::uint8_t* buffer, std::size_t size) noexcept;
 
     FCPP_EXPORT std::uint8_t getPRGBanks() const noexcept;
     FCPP_EXPORT std::uint8_t getCHRBanks() const noexcept;
     FCPP_EXPORT std::uint8_t getMapperType() const noexcept;
     FCPP_EXPORT MirrorType getMirrorType() const noexcept;
-    FCPP_EXPORT std::uint8_t* getPRGData() const noexcept;
+    FCPP_EXPORT const std::uint8_t* getPRGData() const noexcept;
     FCPP_EXPORT std::size_t getPRGSize() const noexcept;
-    FCPP_EXPORT std::uint8_t* getCHRData() const noexcept;
+    FCPP_EXPORT const std::uint8_t* getCHRData() const noexcept;
     FCPP_EXPORT std::size_t getCHRSize() const noexcept;
+    // nullptr if the cartridge has video rom
+    FCPP_EXPORT std::uint8_t* getCHRRAM() noexcept;
 
     FCPP_EXPORT std::uint8_t readPRG(std::uint32_t addr) noexcept;
     FCPP_EXPORT void writePRG(std::uint32_t addr, std::uint8_t data) noexcept;
@@ -17,6 +17,11 @@ public:
     virtual void setPixel(int x, int y, std::uint32_t color) noexcept = 0;
     virtual void completedSignal() noexcept = 0;
     virtual const std::uint32_t* getPaletteTable() noexcept = 0;
+    // asked when a frame may repeat the last one, true if the buffer still holds the last frame,
+    // then pixels are only sent from where the frame starts to differ, if at all
+    virtual bool keepsLastFrame() noexcept { return false; }
+    // before completedSignal(), whether the frame is known to be identical to the last one
+    virtual void setFrameUnchanged(bool /* unchanged */) noexcept {}
 };
 
 #endif
@@ -22,6 +22,7 @@ public:
 
     virtual void write(std::uint8_t data) noexcept = 0;
     virtual std::uint8_t read() noexcept = 0;
+    virtual std::unique_ptr<Joypad> clone() const = 0;
 
     void set(InputScanner* inputScanner) noexcept;
 protected:
@@ -50,6 +51,7 @@ public:
 
     void write(std::uint8_t data) noexcept override;
     std::uint8_t read() noexcept override;
+    std::unique_ptr<Joypad> clone() const override;
 private:
     const std::unique_ptr<StandardJoypadData> dptr;
 };
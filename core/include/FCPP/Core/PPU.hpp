@@ -9,6 +9,7 @@
 namespace fcpp::core
 {
     class PPU;
+    class RenderThread;
 }
 
 class fcpp::core::PPU
@@ -22,13 +23,17 @@ public:
     {
         enum class Type
         {
-            SpriteLimit, AddressBus
+            SpriteLimit, AddressBus, Position
         };
     };
 private:
     struct PPUData;
+public:
+    // ARGB colors used when the frame buffer has no palette table
+    static const std::uint32_t* getDefaultPaletteTable() noexcept;
 public:
     PPU();
+    PPU(const PPU& other);
     ~PPU() noexcept;
 
     void connect(void* p) noexcept;
@@ -37,12 +42,20 @@ public:
     void reset() noexcept;
 
     void exec() noexcept;
+    // writes outside of the PPU registers that may change the output, e.g. mapper registers
+    void track(std::uint16_t addr, std::uint8_t data) noexcept;
+    // true if rendering leaves OAM alone for the next dots, so OAM DMA can be written at once
+    bool idleOAM(unsigned int dots) const noexcept;
+    // 256 bytes from OAMADDR as written by OAM DMA
+    void writeOAM(const std::uint8_t* data) noexcept;
 
     template<Registers reg> std::uint8_t get() noexcept;
     template<Registers reg> void set(std::uint8_t v) noexcept;
     template<State::Type type> unsigned int get() const noexcept;
     template<State::Type type> void set(unsigned int v) noexcept;
     void set(FrameBuffer* frameBuffer) noexcept;
+    // nullptr to draw on the emulation thread
+    void set(RenderThread* renderThread) noexcept;
 private:
     const std::unique_ptr<PPUData> dptr;
 };
@@ -0,0 +1,55 @@
+#ifndef FCPP_CORE_PATTERN_HPP
+#define FCPP_CORE_PATTERN_HPP
+
+#include <cstdint>
+
+namespace fcpp::core
+{
+    struct PatternRow;
+}
+
+// a row of 8 pattern pixels with both bit planes and decoded to 2-bit indices, the leftmost pixel in the highest bits
+struct fcpp::core::PatternRow
+{
+    std::uint8_t low = 0, high = 0;
+    std::uint16_t pixels = 0;
+    std::uint16_t flipped = 0; // mirrored horizontally
+};
+
+namespace fcpp::core::detail
+{
+    // bit n of the plane moves to bit 2n
+    constexpr std::uint32_t spreadPlane(std::uint32_t plane) noexcept
+    {
+        plane = (plane | (plane << 8)) & 0x00ff00ff;
+        plane = (plane | (plane << 4)) & 0x0f0f0f0f;
+        plane = (plane | (plane << 2)) & 0x33333333;
+        return (plane | (plane << 1)) & 0x55555555;
+    }
+    // bit 2n moves to bit n, the inverse of spreadPlane
+    constexpr std::uint16_t gatherPlane(std::uint32_t bits) noexcept
+    {
+        bits &= 0x55555555;
+        bits = (bits | (bits >> 1)) & 0x33333333;
+        bits = (bits | (bits >> 2)) & 0x0f0f0f0f;
+        bits = (bits | (bits >> 4)) & 0x00ff00ff;
+        return static_cast<std::uint16_t>(bits | (bits >> 8));
+    }
+    constexpr std::uint8_t reversePlane(std::uint8_t plane) noexcept
+    {
+        plane = static_cast<std::uint8_t>((plane & 0xf0) >> 4 | (plane & 0x0f) << 4);
+        plane = static_cast<std::uint8_t>((plane & 0xcc) >> 2 | (plane & 0x33) << 2);
+        return static_cast<std::uint8_t>((plane & 0xaa) >> 1 | (plane & 0x55) << 1);
+    }
+    constexpr PatternRow decodePattern(const std::uint8_t low, const std::uint8_t high) noexcept
+    {
+        PatternRow row{};
+        row.low = low;
+        row.high = high;
+        row.pixels = static_cast<std::uint16_t>(spreadPlane(high) << 1 | spreadPlane(low));
+        row.flipped = static_cast<std::uint16_t>(spreadPlane(reversePlane(high)) << 1 | spreadPlane(reversePlane(low)));
+        return row;
+    }
+}
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef FCPP_CORE_PROFILER_HPP
+#define FCPP_CORE_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+namespace fcpp::core
+{
+    class Profiler;
+}
+
+/*
+* Performance counters of a machine, only built with FCPP_ENABLE_PROFILER, otherwise all hooks are empty.
+* Events are counted exactly, wall time of CPU, PPU and APU is sampled once every SampleInterval CPU cycles and scaled.
+* Time spent in the frame and sample buffers is measured exactly as output and left out of the PPU and APU.
+*/
+class fcpp::core::Profiler
+{
+public:
+#ifdef FCPP_ENABLE_PROFILER
+    static constexpr bool Enabled = true;
+#else
+    static constexpr bool Enabled = false;
+#endif
+    static constexpr std::uint64_t SampleInterval = 64;
+
+    enum class Event
+    {
+        Instruction, Cycle,
+        RAM, PPURegister, APURegister, PRG, CHR, VRAM,
+        MapperSync, DMACycle, NMI, IRQ,
+        Count
+    };
+    enum class Section
+    {
+        CPU, PPU, APU, Output,
+        Count
+    };
+
+    struct Counters
+    {
+        std::uint64_t instructions = 0;
+        std::uint64_t cycles = 0;
+        // CPU bus accesses, APU registers include the IO ports
+        std::uint64_t ramAccesses = 0;
+        std::uint64_t ppuRegisterAccesses = 0;
+        std::uint64_t apuRegisterAccesses = 0;
+        std::uint64_t prgAccesses = 0;
+        // PPU bus accesses, VRAM includes the palette
+        std::uint64_t chrAccesses = 0;
+        std::uint64_t vramAccesses = 0;
+        std::uint64_t mapperSyncs = 0;
+        std::uint64_t dmaCycles = 0;
+        std::uint64_t nmis = 0;
+        std::uint64_t irqs = 0;
+        // wall time in seconds
+        double cpuTime = 0.0;
+        double ppuTime = 0.0;
+        double apuTime = 0.0;
+        double outputTime = 0.0;
+    };
+public:
+    Profiler() = default;
+    ~Profiler() = default;
+
+    Counters get() const noexcept;
+    void reset() noexcept;
+
+    void count(Event event, std::uint64_t n = 1) noexcept;
+    // at the start of each CPU cycle, true if the cycle should be sampled
+    bool sample(std::uint64_t cycle) noexcept;
+    // after a sampled cycle, the CPU is timed until the next cycle starts
+    void resume() noexcept;
+    template<typename Function>
+    void sample(Section section, Function&& function) noexcept;
+    template<typename Function>
+    void measure(Section section, Function&& function) noexcept;
+private:
+    // excludes the cost of reading the clock, which is close to a sampled cycle
+    static double elapsed(std::chrono::steady_clock::time_point begin) noexcept;
+    static double overhead() noexcept;
+private:
+    bool resumed = false;
+    std::chrono::steady_clock::time_point resumeTime{};
+    std::uint64_t events[static_cast<int>(Event::Count)]{};
+    double times[static_cast<int>(Section::Count)]{};
+};
+
+inline fcpp::core::Profiler::Counters fcpp::core::Profiler::get() const noexcept
+{
+    Counters counters{};
+    counters.instructions = events[static_cast<int>(Event::Instruction)];
+    counters.cycles = events[static_cast<int>(Event::Cycle)];
+    counters.ramAccesses = events[static_cast<int>(Event::RAM)];
+    counters.ppuRegisterAccesses = events[static_cast<int>(Event::PPURegister)];
+    counters.apuRegisterAccesses = events[static_cast<int>(Event::APURegister)];
+    counters.prgAccesses = events[static_cast<int>(Event::PRG)];
+    counters.chrAccesses = events[static_cast<int>(Event::CHR)];
+    counters.vramAccesses = events[static_cast<int>(Event::VRAM)];
+    counters.mapperSyncs = events[static_cast<int>(Event::MapperSync)];
+    counters.dmaCycles = events[static_cast<int>(Event::DMACycle)];
+    counters.nmis = events[static_cast<int>(Event::NMI)];
+    counters.irqs = events[static_cast<int>(Event::IRQ)];
+    counters.cpuTime = times[static_cast<int>(Section::CPU)];
+    counters.ppuTime = times[static_cast<int>(Section::PPU)];
+    counters.apuTime = times[static_cast<int>(Section::APU)];
+    counters.outputTime = times[static_cast<int>(Section::Output)];
+    return counters;
+}
+inline void fcpp::core::Profiler::reset() noexcept
+{
+    *this = {};
+}
+inline void fcpp::core::Profiler::count(const Event event, const std::uint64_t n) noexcept
+{
+    if constexpr (Enabled) events[static_cast<int>(event)] += n;
+}
+inline bool fcpp::core::Profiler::sample(const std::uint64_t cycle) noexcept
+{
+    if constexpr (Enabled)
+    {
+        events[static_cast<int>(Event::Cycle)]++;
+        if (resumed)
+        {
+            resumed = false;
+            times[static_cast<int>(Section::CPU)] += elapsed(resumeTime) * SampleInterval;
+        }
+        return !(cycle % SampleInterval);
+    }
+    else return false;
+}
+inline void fcpp::core::Profiler::resume() noexcept
+{
+    if constexpr (Enabled)
+    {
+        resumed = true;
+        resumeTime = std::chrono::steady_clock::now();
+    }
+}
+template<typename Function>
+inline void fcpp::core::Profiler::sample(const Section section, Function&& function) noexcept
+{
+    if constexpr (Enabled)
+    {
+        auto output = times[static_cast<int>(Section::Output)];
+        auto begin = std::chrono::steady_clock::now();
+        std::forward<Function>(function)();
+        auto time = elapsed(begin) - (times[static_cast<int>(Section::Output)] - output);
+        times[static_cast<int>(section)] += time * SampleInterval;
+    }
+    else std::forward<Function>(function)();
+}
+template<typename Function>
+inline void fcpp::core::Profiler::measure(const Section section, Function&& function) noexcept
+{
+    if constexpr (Enabled)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        std::forward<Function>(function)();
+        times[static_cast<int>(section)] += elapsed(begin);
+    }
+    else std::forward<Function>(function)();
+}
+inline double fcpp::core::Profiler::elapsed(const std::chrono::steady_clock::time_point begin) noexcept
+{
+    auto time = std::chrono::duration<double>{ std::chrono::steady_clock::now() - begin }.count() - overhead();
+    return time > 0.0 ? time : 0.0;
+}
+inline double fcpp::core::Profiler::overhead() noexcept
+{
+    static const double value = []()
+    {
+        auto min = std::chrono::steady_clock::duration::max();
+        for (int i = 0; i < 64; i++)
+        {
+            auto begin = std::chrono::steady_clock::now();
+            auto time = std::chrono::steady_clock::now() - begin;
+            if (time < min) min = time;
+        }
+        return std::chrono::duration<double>{ min }.count();
+    }();
+    return value;
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef FCPP_CORE_ROMPACK_HPP
+#define FCPP_CORE_ROMPACK_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include <FCPPExport.hpp>
+
+#include "FCPP/Core/INES.hpp"
+
+namespace fcpp::core
+{
+    class ROMPack;
+}
+
+// many iNES files in one mapped archive, roms loaded from it share the mapping
+class fcpp::core::ROMPack
+{
+private:
+    struct ROMPackData;
+public:
+    // pack files into a new archive at path, entries are named after the file names
+    FCPP_EXPORT static bool create(const char* path, const char* const* files, std::size_t count);
+public:
+    FCPP_EXPORT ROMPack();
+    FCPP_EXPORT ROMPack(ROMPack&&) noexcept;
+    FCPP_EXPORT ~ROMPack() noexcept;
+    FCPP_EXPORT ROMPack& operator=(ROMPack&&) noexcept;
+
+    FCPP_EXPORT bool open(const char* path);
+
+    FCPP_EXPORT std::size_t count() const noexcept;
+    // nullptr if idx is out of range
+    FCPP_EXPORT const char* name(std::size_t idx) const noexcept;
+
+    FCPP_EXPORT bool load(std::size_t idx, INES& rom) const noexcept;
+    FCPP_EXPORT bool load(const char* name, INES& rom) const noexcept;
+private:
+    std::unique_ptr<ROMPackData> dptr;
+};
+
+#endif
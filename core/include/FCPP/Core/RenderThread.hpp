@@ -0,0 +1,44 @@
+#ifndef FCPP_CORE_RENDER_THREAD_HPP
+#define FCPP_CORE_RENDER_THREAD_HPP
+
+#include <cstdint>
+#include <memory>
+
+namespace fcpp::core
+{
+    class FC;
+    class FrameBuffer;
+    class RenderThread;
+}
+
+/*
+* Draws the frames of a machine on a second thread.
+* A copy of the PPU, bus and cartridge is taken at the start of each frame and replays the PPU inputs
+* the machine logs while it keeps emulating, the copy runs at most one scanline behind.
+* The machine itself still does all fetches, sprite evaluation and the sprite zero hit,
+* so everything the CPU and the mappers can see stays on the emulation thread.
+*/
+class fcpp::core::RenderThread
+{
+private:
+    struct RenderThreadData;
+public:
+    static constexpr std::size_t MaxEvents = 4096;
+public:
+    // fc must have its cartridge inserted, only its components are kept
+    explicit RenderThread(FC* fc);
+    ~RenderThread() noexcept;
+
+    // at the start of the pre-render line, false if the frame has to be drawn by the machine
+    bool begin(FrameBuffer* frameBuffer, unsigned int spriteLimit) noexcept;
+    // a PPU input at a position in dots since the start of the frame, false once the log is full
+    bool push(std::uint32_t position, std::uint16_t addr, std::uint8_t value, bool read) noexcept;
+    // the machine has passed position, every input before it is logged
+    void publish(std::uint32_t position) noexcept;
+    // waits until everything before position is drawn, the machine draws the rest of the frame
+    void finish(std::uint32_t position) noexcept;
+private:
+    const std::unique_ptr<RenderThreadData> dptr;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef FCPP_CORE_RUNAHEAD_HPP
+#define FCPP_CORE_RUNAHEAD_HPP
+
+#include <memory>
+
+#include <FCPPExport.hpp>
+
+#include "FCPP/Core/FC.hpp"
+
+namespace fcpp::core
+{
+    class RunAhead;
+}
+
+/*
+* Hide input latency by presenting a frame from the future.
+* Every frame the machine runs one frame with audio only, saves, runs ahead with the current input
+* and presents the last frame, then rolls back. With a second instance the look-ahead frames are
+* emulated on a copy, so the main machine and its audio are never rolled back.
+*/
+class fcpp::core::RunAhead
+{
+private:
+    struct RunAheadData;
+public:
+    // fc must outlive this object, its frame and sample buffer are replaced by connect()
+    FCPP_EXPORT explicit RunAhead(FC* fc);
+    FCPP_EXPORT ~RunAhead() noexcept;
+
+    FCPP_EXPORT void connect(FrameBuffer* frameBuffer) noexcept;
+    FCPP_EXPORT void connect(SampleBuffer* sampleBuffer) noexcept;
+
+    // 0 to disable, max 8
+    FCPP_EXPORT void setFrames(int frames) noexcept;
+    FCPP_EXPORT int getFrames() const noexcept;
+    // the second instance is a copy of fc, enable it after inserting the cartridge
+    FCPP_EXPORT void setSecondInstance(bool enable);
+
+    // emulate one frame
+    FCPP_EXPORT void exec() noexcept;
+private:
+    const std::unique_ptr<RunAheadData> dptr;
+};
+
+#endif
@@ -3,11 +3,17 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 
 #include <FCPPExport.hpp>
 
+// snapshot data is little-endian, integers can be copied directly on little-endian hosts
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_WIN32)
+#   define FCPP_CORE_SNAPSHOT_LITTLE_ENDIAN
+#endif
+
 namespace fcpp::core
 {
     class Snapshot;
@@ -81,10 +87,27 @@ private:
     std::unique_ptr<SnapshotData> dptr;
 };
 
+inline void fcpp::core::Snapshot::Writer::access(const bool data) noexcept
+{
+    access(static_cast<std::uint8_t>(data));
+}
+inline void fcpp::core::Snapshot::Writer::access(const std::uint8_t data) noexcept
+{
+    buffer[pos++] = data;
+}
+inline void fcpp::core::Snapshot::Writer::access(const void* const data, const std::size_t length) noexcept
+{
+    std::memcpy(buffer + pos, data, length);
+    pos += length;
+}
 template <typename Integer, std::enable_if_t<std::is_integral_v<Integer>>*>
 inline void fcpp::core::Snapshot::Writer::access(const Integer data) noexcept
 {
+#ifdef FCPP_CORE_SNAPSHOT_LITTLE_ENDIAN
+    access(&data, sizeof(Integer));
+#else
     for (std::size_t i = 0; i < sizeof(Integer); i++) access(static_cast<std::uint8_t>((data >> (8 * i)) & 0xff));
+#endif
 }
 template <typename Register, typename Integer, std::enable_if_t<std::is_class_v<Register>>*>
 inline void fcpp::core::Snapshot::Writer::access(const Register& data) noexcept
@@ -97,9 +120,27 @@ inline void fcpp::core::Snapshot::Writer::access(const Enum data) noexcept
     access(static_cast<std::underlying_type_t<Enum>>(data));
 }
 
+inline void fcpp::core::Snapshot::Reader::access(bool& data) const noexcept
+{
+    std::uint8_t value = 0;
+    access(value);
+    data = value;
+}
+inline void fcpp::core::Snapshot::Reader::access(std::uint8_t& data) const noexcept
+{
+    data = buffer[pos++];
+}
+inline void fcpp::core::Snapshot::Reader::access(void* const data, const std::size_t length) const noexcept
+{
+    std::memcpy(data, buffer + pos, length);
+    pos += length;
+}
 template <typename Integer, std::enable_if_t<std::is_integral_v<Integer>>*>
 inline void fcpp::core::Snapshot::Reader::access(Integer& data) const noexcept
 {
+#ifdef FCPP_CORE_SNAPSHOT_LITTLE_ENDIAN
+    access(&data, sizeof(Integer));
+#else
     data = 0;
     std::uint8_t value = 0;
     for (std::size_t i = 0; i < sizeof(Integer); i++)
@@ -107,6 +148,7 @@ inline void fcpp::core::Snapshot::Reader::access(Integer& data) const noexcept
         access(value);
         data |= (static_cast<Integer>(value) << (8 * i));
     }
+#endif
 }
 template <typename Register, typename Integer, std::enable_if_t<std::is_class_v<Register>>*>
 inline void fcpp::core::Snapshot::Reader::access(Register& data) const noexcept
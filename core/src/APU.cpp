@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <array>
 #include <cstddef>
 
@@ -21,6 +22,19 @@ namespace fcpp::core::detail
             }
             return false;
         }
+        // same as calling step() steps times, returns how many times it reloaded
+        unsigned int skip(unsigned int steps) noexcept
+        {
+            if (steps <= counter)
+            {
+                counter -= steps;
+                return 0;
+            }
+            steps -= counter + 1u;
+            unsigned int length = period + 1u;
+            counter = static_cast<std::uint16_t>(period - steps % length);
+            return 1 + steps / length;
+        }
     };
 
     class Envelope
@@ -302,6 +316,7 @@ namespace fcpp::core::detail
         std::uint8_t output() const noexcept;
         template<int idx> void set(std::uint8_t v) noexcept;
         template<typename Unit, int... idx> void step() noexcept;
+        void skip(unsigned int steps) noexcept;
         template<typename Accessor> void access(Accessor& accessor) noexcept;
     private:
         std::uint8_t dutyCycle = 0;
@@ -344,6 +359,10 @@ namespace fcpp::core::detail
     {
         if (timer.step()) offset = (offset + 1) & 7;
     }
+    inline void Pulse::skip(const unsigned int steps) noexcept
+    {
+        offset = (offset + timer.skip(steps)) & 7;
+    }
     template<> inline void Pulse::step<Envelope>() noexcept
     {
         envelope.step();
@@ -376,6 +395,7 @@ namespace fcpp::core::detail
         std::uint8_t output() const noexcept;
         template<int idx> void set(std::uint8_t v) noexcept;
         template<typename Unit> void step() noexcept;
+        void skip(unsigned int steps) noexcept;
         template<typename Accessor> void access(Accessor& accessor) noexcept;
     private:
         std::uint8_t offset = 0;
@@ -411,6 +431,12 @@ namespace fcpp::core::detail
         if (timer.step() && !linearCounter.zero() && !lengthCounter.zero() && !((timer.period < 3) || (timer.period > 0x07ff)))
             offset = (offset + 1) & 31;
     }
+    inline void Triangle::skip(const unsigned int steps) noexcept
+    {
+        auto count = timer.skip(steps);
+        if (count && !linearCounter.zero() && !lengthCounter.zero() && !((timer.period < 3) || (timer.period > 0x07ff)))
+            offset = (offset + count) & 31;
+    }
     template<> inline void Triangle::step<LengthCounter>() noexcept
     {
         lengthCounter.step();
@@ -433,7 +459,10 @@ namespace fcpp::core::detail
         std::uint8_t output() const noexcept;
         template<int idx> void set(std::uint8_t v) noexcept;
         template<typename Unit> void step() noexcept;
+        void skip(unsigned int steps) noexcept;
         template<typename Accessor> void access(Accessor& accessor) noexcept;
+    private:
+        void shift() noexcept;
     private:
         std::uint16_t shiftRegister = 0x01;
         bool mode = false;
@@ -463,18 +492,23 @@ namespace fcpp::core::detail
         lengthCounter.set(v >> 3);
         envelope.start();
     }
-    template<> inline void Noise::step<Timer>() noexcept
+    inline void Noise::shift() noexcept
     {
-        if (timer.step())
-        {
-            std::uint16_t shift = mode ? 6 : 1;
+        std::uint16_t shift = mode ? 6 : 1;
 
-            std::uint16_t bit0 = shiftRegister & 1;
-            std::uint16_t other = (shiftRegister >> shift) & 1;
+        std::uint16_t bit0 = shiftRegister & 1;
+        std::uint16_t other = (shiftRegister >> shift) & 1;
 
-            shiftRegister >>= 1;
-            shiftRegister |= (bit0 ^ other) << 14;
-        }
+        shiftRegister >>= 1;
+        shiftRegister |= (bit0 ^ other) << 14;
+    }
+    template<> inline void Noise::step<Timer>() noexcept
+    {
+        if (timer.step()) shift();
+    }
+    inline void Noise::skip(const unsigned int steps) noexcept
+    {
+        for (auto count = timer.skip(steps); count; count--) shift();
     }
     template<> inline void Noise::step<Envelope>() noexcept
     {
@@ -496,7 +530,7 @@ namespace fcpp::core::detail
     class DMC
     {
     public:
-        void connect(Clock* clock, Bus* bus, CPU* cpu) noexcept;
+        void connect(Clock* clock, Bus* bus, CPU* cpu, Profiler* profiler) noexcept;
         Buffer& getBuffer() noexcept;
         bool zeroBytesRemaining() const noexcept;
         void resetBytesRemaining() noexcept;
@@ -507,6 +541,9 @@ namespace fcpp::core::detail
         std::uint8_t output() const noexcept;
         template<int idx> void set(std::uint8_t v) noexcept;
         template<typename Unit> void step() noexcept;
+        // cycles until the timer clocks the output unit, which may start a memory read
+        unsigned int next() const noexcept;
+        void skip(unsigned int steps) noexcept;
         template<typename Accessor> void access(Accessor& accessor) noexcept;
     private:
         std::uint16_t bytesRemainingCounter = 0;
@@ -528,16 +565,18 @@ namespace fcpp::core::detail
         Clock* clock = nullptr;
         Bus* bus = nullptr;
         CPU* cpu = nullptr;
+        Profiler* profiler = nullptr;
     private:
         static constexpr std::uint16_t sequenceLookupTable[16] = {
             428, 380, 340, 320, 286, 254, 226, 214, 190, 160, 142, 128, 106,  84,  72,  54
         };
     };
-    inline void DMC::connect(Clock* const clock, Bus* const bus, CPU* const cpu) noexcept
+    inline void DMC::connect(Clock* const clock, Bus* const bus, CPU* const cpu, Profiler* const profiler) noexcept
     {
         this->clock = clock;
         this->bus = bus;
         this->cpu = cpu;
+        this->profiler = profiler;
     }
     inline Buffer& DMC::getBuffer() noexcept
     {
@@ -570,6 +609,7 @@ namespace fcpp::core::detail
         loading = true;
         unsigned int stalled = cpu->get<CPU::State::Type::DMAState>();
         if (stalled == CPU::State::DMA_STATE_DISABLE) stalled = cpu->get<CPU::State::Type::TickState>() == CPU::State::TICK_STATE_READ ? 4 : 3;
+        profiler->count(Profiler::Event::DMACycle, stalled);
         for (unsigned int i = 0; i < stalled; i++) clock->tick();
 
         buffer.set(bus->read<CPU>(addressCounter));
@@ -624,6 +664,14 @@ namespace fcpp::core::detail
             }
         }
     }
+    inline unsigned int DMC::next() const noexcept
+    {
+        return timer.counter + 1u;
+    }
+    inline void DMC::skip(const unsigned int steps) noexcept
+    {
+        timer.counter -= static_cast<std::uint16_t>(steps);
+    }
     template<typename Accessor>
     inline void DMC::access(Accessor& accessor) noexcept
     {
@@ -722,6 +770,14 @@ namespace fcpp::core::detail
                 }
                 return false;
             }
+            unsigned int next() const noexcept
+            {
+                return counter < 1.0 ? 1 : static_cast<unsigned int>(counter - 1.0) + 1;
+            }
+            void skip(const unsigned int steps) noexcept
+            {
+                counter -= steps;
+            }
             void init(const double p) noexcept
             {
                 period = p;
@@ -746,16 +802,30 @@ namespace fcpp::core::detail
             {
                 return stepModeFlag ? 5 : 4;
             }
+            unsigned int next() const noexcept
+            {
+                static constexpr int fourStep[] = { 3728 * 2 + 1, 7456 * 2 + 1, 11185 * 2 + 1, 14914 * 2, 14914 * 2 + 1, 14915 * 2 };
+                static constexpr int fiveStep[] = { 3728 * 2 + 1, 7456 * 2 + 1, 11185 * 2 + 1, 18640 * 2 + 1, 18641 * 2 };
+                if (stepModeFlag) { for (auto step : fiveStep) if (step > counter) return step - counter; }
+                else for (auto step : fourStep) if (step > counter) return step - counter;
+                return 1;
+            }
         };
     private:
         double output() const noexcept;
         template<typename Unit> void step() noexcept;
+        unsigned int next() const noexcept;
+        void skip(unsigned int cycles, std::uint64_t first) noexcept;
+        void tick() noexcept;
     public:
-        void connect(Bus* bus, Clock* clock, CPU* cpu) noexcept;
+        void connect(Bus* bus, Clock* clock, CPU* cpu, Profiler* profiler) noexcept;
         void setSampleBuffer(SampleBuffer* sampleBuffer) noexcept;
         template<typename Accessor> void access(Accessor& accessor) noexcept;
         void clear() noexcept;
         void exec() noexcept;
+        // catch up with the clock and step every cycle until schedule()
+        void sync() noexcept;
+        void schedule() noexcept;
 
         template<int idx> std::uint8_t get() noexcept;
         template<int idx> void set(std::uint8_t v) noexcept;
@@ -771,9 +841,15 @@ namespace fcpp::core::detail
         Filters filters{};
 
         bool interruptFlag = false;
+
+        // cycles are accumulated and skipped in bulk until the next one that has an observable effect
+        unsigned int pendingCycles = 0;
+        unsigned int nextCycles = 1;
+        bool exact = false;
     private:
         Clock* clock = nullptr;
         CPU* cpu = nullptr;
+        Profiler* profiler = nullptr;
         SampleBuffer* sampleBuffer = nullptr;
     private:
         static constexpr auto pulseTable{ []() constexpr {
@@ -862,11 +938,12 @@ namespace fcpp::core::detail
             }
         }
     }
-    void APUImpl::connect(Bus* const bus, Clock* const clock, CPU* const cpu) noexcept
+    void APUImpl::connect(Bus* const bus, Clock* const clock, CPU* const cpu, Profiler* const profiler) noexcept
     {
         this->cpu = cpu;
         this->clock = clock;
-        dmc.connect(clock, bus, cpu);
+        this->profiler = profiler;
+        dmc.connect(clock, bus, cpu, profiler);
     }
     void APUImpl::setSampleBuffer(SampleBuffer* const sampleBuffer) noexcept
     {
@@ -899,11 +976,57 @@ namespace fcpp::core::detail
         interruptFlag = false;
         sampleTimer.reload();
     }
-    inline void APUImpl::exec() noexcept
+    inline unsigned int APUImpl::next() const noexcept
+    {
+        return std::min({ sampleTimer.next(), frameCounter.next(), dmc.next() });
+    }
+    inline void APUImpl::skip(const unsigned int cycles, const std::uint64_t first) noexcept
+    {   // no channel output, IRQ or DMC memory read happens in these cycles
+        if (!cycles) return;
+        auto pulseCycles = (cycles + (first & 1)) / 2;
+        pulse1.skip(pulseCycles);
+        pulse2.skip(pulseCycles);
+        triangle.skip(cycles);
+        noise.skip(cycles);
+        dmc.skip(cycles);
+        frameCounter.counter += cycles;
+        sampleTimer.skip(cycles);
+    }
+    inline void APUImpl::tick() noexcept
     {
         step<Timer>();
         step<FrameCounter>();
-        if (sampleTimer.step()) sampleBuffer->sendSample(filters(output()));
+        if (sampleTimer.step())
+        {
+            auto sample = filters(output());
+            profiler->measure(Profiler::Section::Output, [this, sample]() { sampleBuffer->sendSample(sample); });
+        }
+    }
+    inline void APUImpl::exec() noexcept
+    {
+        if (++pendingCycles < nextCycles) return;
+        if (exact)
+        {   // cycles stalled by a DMC memory read, or a register access in progress
+            pendingCycles = 0;
+            tick();
+            return;
+        }
+        pendingCycles--;
+        sync();
+        tick();
+        schedule();
+    }
+    inline void APUImpl::sync() noexcept
+    {
+        skip(pendingCycles, clock->getCPUCycles() - pendingCycles);
+        pendingCycles = 0;
+        nextCycles = 1;
+        exact = true;
+    }
+    inline void APUImpl::schedule() noexcept
+    {
+        exact = false;
+        nextCycles = next();
     }
     template<> inline std::uint8_t APUImpl::get<0x15>() noexcept
     {
@@ -1030,24 +1153,31 @@ struct fcpp::core::APU::APUData
 };
 
 fcpp::core::APU::APU() : dptr(std::make_unique<APUData>()) {}
+fcpp::core::APU::APU(const APU& other) : dptr(std::make_unique<APUData>(*other.dptr)) {}
 fcpp::core::APU::~APU() noexcept = default;
 
 void fcpp::core::APU::connect(void* const p) noexcept
 {
     auto fptr = static_cast<FC*>(p);
-    dptr->impl.connect(fptr->getBus(), fptr->getClock(), fptr->getCPU());
+    dptr->impl.connect(fptr->getBus(), fptr->getClock(), fptr->getCPU(), fptr->getProfiler());
 }
 void fcpp::core::APU::save(void* const p) noexcept
 {
+    dptr->impl.sync();
     dptr->impl.access(static_cast<Snapshot*>(p)->getWriter());
+    dptr->impl.schedule();
 }
 void fcpp::core::APU::load(void* const p) noexcept
 {
+    dptr->impl.sync();
     dptr->impl.access(static_cast<Snapshot*>(p)->getReader());
+    dptr->impl.schedule();
 }
 void fcpp::core::APU::reset() noexcept
 {
+    dptr->impl.sync();
     dptr->impl.clear();
+    dptr->impl.schedule();
 }
 
 void fcpp::core::APU::exec() noexcept
@@ -1058,16 +1188,23 @@ void fcpp::core::APU::exec() noexcept
 template<int reg>
 std::uint8_t fcpp::core::APU::get() noexcept
 {
-    return dptr->impl.get<reg>();
+    dptr->impl.sync();
+    auto ret = dptr->impl.get<reg>();
+    dptr->impl.schedule();
+    return ret;
 }
 template<int reg>
 void fcpp::core::APU::set(const std::uint8_t v) noexcept
 {
+    dptr->impl.sync();
     dptr->impl.set<reg>(v);
+    dptr->impl.schedule();
 }
 void fcpp::core::APU::set(SampleBuffer* const sampleBuffer) noexcept
 {
+    dptr->impl.sync();
     dptr->impl.setSampleBuffer(sampleBuffer);
+    dptr->impl.schedule();
 }
 
 template std::uint8_t fcpp::core::APU::get<0x15>() noexcept;
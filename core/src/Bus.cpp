@@ -22,11 +22,28 @@ namespace fcpp::core::detail
             return addr & 0x0fff;
         }
     }
+    inline static Profiler::Event cpuRegion(const std::uint16_t addr) noexcept
+    {
+        if (addr < 0x2000) return Profiler::Event::RAM;
+        else if (addr < 0x4000) return Profiler::Event::PPURegister;
+        else if (addr < 0x4020) return Profiler::Event::APURegister;
+        else return Profiler::Event::PRG;
+    }
+    inline static Profiler::Event ppuRegion(const std::uint16_t addr) noexcept
+    {
+        return (addr & 0x3fff) < 0x2000 ? Profiler::Event::CHR : Profiler::Event::VRAM;
+    }
 }
 
 struct fcpp::core::Bus::BusData
 {
+    CPU* cpu = nullptr;
+    PPU* ppu = nullptr;
+    APU* apu = nullptr;
+    Cartridge* cartridge = nullptr;
     FC* fc = nullptr;
+    Profiler* profiler = nullptr;
+
     std::uint8_t cpuOpenBusData = 0;
     std::uint8_t ram[0x0800]{};
     std::uint8_t vram[0x1000]{};
@@ -34,11 +51,18 @@ struct fcpp::core::Bus::BusData
 };
 
 fcpp::core::Bus::Bus() : dptr(std::make_unique<BusData>()) {}
+fcpp::core::Bus::Bus(const Bus& other) : dptr(std::make_unique<BusData>(*other.dptr)) {}
 fcpp::core::Bus::~Bus() noexcept = default;
 
 void fcpp::core::Bus::connect(void* const p) noexcept
 {
-    dptr->fc = static_cast<FC*>(p);
+    auto fptr = static_cast<FC*>(p);
+    dptr->cpu = fptr->getCPU();
+    dptr->ppu = fptr->getPPU();
+    dptr->apu = fptr->getAPU();
+    dptr->cartridge = fptr->getCartridge();
+    dptr->fc = fptr;
+    dptr->profiler = fptr->getProfiler();
 }
 void fcpp::core::Bus::save(void* const p) noexcept
 {
@@ -66,32 +90,33 @@ void fcpp::core::Bus::reset(const std::uint8_t v) noexcept
 template<>
 FCPP_EXPORT std::uint8_t fcpp::core::Bus::read<fcpp::core::CPU>(std::uint16_t addr) noexcept
 {
+    dptr->profiler->count(detail::cpuRegion(addr));
     if (addr < 0x2000) return dptr->cpuOpenBusData = dptr->ram[addr & 0x07ff];
     else if (addr < 0x4000)
     {
         switch (addr & 0x0007)
         {
         case 0:
-            return dptr->cpuOpenBusData = dptr->fc->getPPU()->get<PPU::Registers::PPUCTRL>();
+            return dptr->cpuOpenBusData = dptr->ppu->get<PPU::Registers::PPUCTRL>();
         case 1:
-            return dptr->cpuOpenBusData = dptr->fc->getPPU()->get<PPU::Registers::PPUMASK>();
+            return dptr->cpuOpenBusData = dptr->ppu->get<PPU::Registers::PPUMASK>();
         case 2:
-            return dptr->cpuOpenBusData = dptr->fc->getPPU()->get<PPU::Registers::PPUSTATUS>();
+            return dptr->cpuOpenBusData = dptr->ppu->get<PPU::Registers::PPUSTATUS>();
         case 3:
-            return dptr->cpuOpenBusData = dptr->fc->getPPU()->get<PPU::Registers::OAMADDR>();
+            return dptr->cpuOpenBusData = dptr->ppu->get<PPU::Registers::OAMADDR>();
         case 4:
-            return dptr->cpuOpenBusData = dptr->fc->getPPU()->get<PPU::Registers::OAMDATA>();
+            return dptr->cpuOpenBusData = dptr->ppu->get<PPU::Registers::OAMDATA>();
         case 5:
-            return dptr->cpuOpenBusData = dptr->fc->getPPU()->get<PPU::Registers::PPUSCROLL>();
+            return dptr->cpuOpenBusData = dptr->ppu->get<PPU::Registers::PPUSCROLL>();
         case 6:
-            return dptr->cpuOpenBusData = dptr->fc->getPPU()->get<PPU::Registers::PPUADDR>();
+            return dptr->cpuOpenBusData = dptr->ppu->get<PPU::Registers::PPUADDR>();
         case 7:
-            return dptr->cpuOpenBusData = dptr->fc->getPPU()->get<PPU::Registers::PPUDATA>();
+            return dptr->cpuOpenBusData = dptr->ppu->get<PPU::Registers::PPUDATA>();
         default:
             return dptr->cpuOpenBusData;
         }
     }
-    else if (addr == 0x4015) return dptr->cpuOpenBusData = dptr->fc->getAPU()->get<0x15>() | (dptr->cpuOpenBusData & 0x20); //APU
+    else if (addr == 0x4015) return dptr->cpuOpenBusData = dptr->apu->get<0x15>() | (dptr->cpuOpenBusData & 0x20); //APU
     else if (addr == 0x4016) //Joypad 1
     {
         auto joypad = dptr->fc->getJoypad(0);
@@ -102,12 +127,13 @@ FCPP_EXPORT std::uint8_t fcpp::core::Bus::read<fcpp::core::CPU>(std::uint16_t ad
         auto joypad = dptr->fc->getJoypad(1);
         return dptr->cpuOpenBusData = (joypad != nullptr) ? joypad->read() : 0;
     }
-    else if (addr >= 0x4100) return dptr->cpuOpenBusData = dptr->fc->getCartridge()->readPRG(addr);
+    else if (addr >= 0x4100) return dptr->cpuOpenBusData = dptr->cartridge->readPRG(addr);
     else return dptr->cpuOpenBusData;
 }
 template<>
 FCPP_EXPORT void fcpp::core::Bus::write<fcpp::core::CPU>(std::uint16_t addr, const std::uint8_t data) noexcept
 {
+    dptr->profiler->count(detail::cpuRegion(addr));
     dptr->cpuOpenBusData = data;
     if (addr < 0x2000) dptr->ram[addr & 0x07ff] = data;
     else if (addr < 0x4000)
@@ -115,28 +141,28 @@ FCPP_EXPORT void fcpp::core::Bus::write<fcpp::core::CPU>(std::uint16_t addr, con
         switch (addr & 0x0007)
         {
         case 0:
-            dptr->fc->getPPU()->set<PPU::Registers::PPUCTRL>(data);
+            dptr->ppu->set<PPU::Registers::PPUCTRL>(data);
             break;
         case 1:
-            dptr->fc->getPPU()->set<PPU::Registers::PPUMASK>(data);
+            dptr->ppu->set<PPU::Registers::PPUMASK>(data);
             break;
         case 2:
-            dptr->fc->getPPU()->set<PPU::Registers::PPUSTATUS>(data);
+            dptr->ppu->set<PPU::Registers::PPUSTATUS>(data);
             break;
         case 3:
-            dptr->fc->getPPU()->set<PPU::Registers::OAMADDR>(data);
+            dptr->ppu->set<PPU::Registers::OAMADDR>(data);
             break;
         case 4:
-            dptr->fc->getPPU()->set<PPU::Registers::OAMDATA>(data);
+            dptr->ppu->set<PPU::Registers::OAMDATA>(data);
             break;
         case 5:
-            dptr->fc->getPPU()->set<PPU::Registers::PPUSCROLL>(data);
+            dptr->ppu->set<PPU::Registers::PPUSCROLL>(data);
             break;
         case 6:
-            dptr->fc->getPPU()->set<PPU::Registers::PPUADDR>(data);
+            dptr->ppu->set<PPU::Registers::PPUADDR>(data);
             break;
         case 7:
-            dptr->fc->getPPU()->set<PPU::Registers::PPUDATA>(data);
+            dptr->ppu->set<PPU::Registers::PPUDATA>(data);
             break;
         }
     }
@@ -145,89 +171,106 @@ FCPP_EXPORT void fcpp::core::Bus::write<fcpp::core::CPU>(std::uint16_t addr, con
         switch (addr & 0xff)
         {
         case 0x00:
-            dptr->fc->getAPU()->set<0x00>(data);
+            dptr->apu->set<0x00>(data);
             break;
         case 0x01:
-            dptr->fc->getAPU()->set<0x01>(data);
+            dptr->apu->set<0x01>(data);
             break;
         case 0x02:
-            dptr->fc->getAPU()->set<0x02>(data);
+            dptr->apu->set<0x02>(data);
             break;
         case 0x03:
-            dptr->fc->getAPU()->set<0x03>(data);
+            dptr->apu->set<0x03>(data);
             break;
         case 0x04:
-            dptr->fc->getAPU()->set<0x04>(data);
+            dptr->apu->set<0x04>(data);
             break;
         case 0x05:
-            dptr->fc->getAPU()->set<0x05>(data);
+            dptr->apu->set<0x05>(data);
             break;
         case 0x06:
-            dptr->fc->getAPU()->set<0x06>(data);
+            dptr->apu->set<0x06>(data);
             break;
         case 0x07:
-            dptr->fc->getAPU()->set<0x07>(data);
+            dptr->apu->set<0x07>(data);
             break;
         case 0x08:
-            dptr->fc->getAPU()->set<0x08>(data);
+            dptr->apu->set<0x08>(data);
             break;
         case 0x0a:
-            dptr->fc->getAPU()->set<0x0a>(data);
+            dptr->apu->set<0x0a>(data);
             break;
         case 0x0b:
-            dptr->fc->getAPU()->set<0x0b>(data);
+            dptr->apu->set<0x0b>(data);
             break;
         case 0x0c:
-            dptr->fc->getAPU()->set<0x0c>(data);
+            dptr->apu->set<0x0c>(data);
             break;
         case 0x0e:
-            dptr->fc->getAPU()->set<0x0e>(data);
+            dptr->apu->set<0x0e>(data);
             break;
         case 0x0f:
-            dptr->fc->getAPU()->set<0x0f>(data);
+            dptr->apu->set<0x0f>(data);
             break;
         case 0x10:
-            dptr->fc->getAPU()->set<0x10>(data);
+            dptr->apu->set<0x10>(data);
             break;
         case 0x11:
-            dptr->fc->getAPU()->set<0x11>(data);
+            dptr->apu->set<0x11>(data);
             break;
         case 0x12:
-            dptr->fc->getAPU()->set<0x12>(data);
+            dptr->apu->set<0x12>(data);
             break;
         case 0x13:
-            dptr->fc->getAPU()->set<0x13>(data);
+            dptr->apu->set<0x13>(data);
             break;
         }
     }
-    else if (addr == 0x4014) dptr->fc->getCPU()->requestDMA(0x2004, data);
-    else if (addr == 0x4015) dptr->fc->getAPU()->set<0x15>(data);
+    else if (addr == 0x4014) dptr->cpu->requestDMA(0x2004, data);
+    else if (addr == 0x4015) dptr->apu->set<0x15>(data);
     else if (addr == 0x4016)
     {
         fcpp::core::Joypad* joypad = nullptr;
         for (int i = 0; (joypad = dptr->fc->getJoypad(i)) != nullptr; i++) joypad->write(data);
     }
-    else if (addr == 0x4017) dptr->fc->getAPU()->set<0x17>(data);
-    else if (addr >= 0x4100) dptr->fc->getCartridge()->writePRG(addr, data);
+    else if (addr == 0x4017) dptr->apu->set<0x17>(data);
+    else if (addr >= 0x4100)
+    {   // PRG RAM has no effect on the PPU
+        if (addr < 0x6000 || addr >= 0x8000) dptr->ppu->track(addr, data);
+        dptr->cartridge->writePRG(addr, data);
+    }
 }
 
 template<>
 FCPP_EXPORT std::uint8_t fcpp::core::Bus::read<fcpp::core::PPU>(std::uint16_t addr) noexcept
 {
+    dptr->profiler->count(detail::ppuRegion(addr));
     addr &= 0x3fff;
-    if (addr < 0x2000) return dptr->fc->getCartridge()->readCHR(addr);
-    else if (addr < 0x3f00) return dptr->vram[detail::nameTableAddress(addr, dptr->fc->getCartridge()->getMirrorType())];
+    if (addr < 0x2000) return dptr->cartridge->readCHR(addr);
+    else if (addr < 0x3f00) return dptr->vram[detail::nameTableAddress(addr, dptr->cartridge->getMirrorType())];
     else return dptr->pram[addr & ((addr & 0x0003) == 0x0000 ? 0x000f : 0x001f)];
 }
 template<>
 FCPP_EXPORT void fcpp::core::Bus::write<fcpp::core::PPU>(std::uint16_t addr, const std::uint8_t data) noexcept
 {
+    dptr->profiler->count(detail::ppuRegion(addr));
     addr &= 0x3fff;
-    if (addr < 0x2000) dptr->fc->getCartridge()->writeCHR(addr, data);
-    else if (addr < 0x3f00) dptr->vram[detail::nameTableAddress(addr, dptr->fc->getCartridge()->getMirrorType())] = data;
+    if (addr < 0x2000) dptr->cartridge->writeCHR(addr, data);
+    else if (addr < 0x3f00) dptr->vram[detail::nameTableAddress(addr, dptr->cartridge->getMirrorType())] = data;
     else dptr->pram[addr & ((addr & 0x0003) == 0x0000 ? 0x000f : 0x001f)] = data;
 }
 
+bool fcpp::core::Bus::copyOAM(const std::uint16_t src, const unsigned int cycles) noexcept
+{   // reading work RAM has no side effects, DMC reads may stall the transfer twice by up to 4 cycles
+    if (src >= 0x2000 || !dptr->ppu->idleOAM(3 * (cycles + 8))) return false;
+    auto data = dptr->ram + (src & 0x07ff);
+    dptr->profiler->count(Profiler::Event::RAM, 0x100);
+    dptr->profiler->count(Profiler::Event::PPURegister, 0x100);
+    dptr->ppu->writeOAM(data);
+    dptr->cpuOpenBusData = data[0xff];
+    return true;
+}
+
 template<>
 FCPP_EXPORT const std::uint8_t* fcpp::core::Bus::dump<fcpp::core::Bus::MemoryType::RAM>() const noexcept
 {
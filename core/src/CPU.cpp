@@ -42,43 +42,52 @@ namespace fcpp::core::detail
             }
         };
 
+        // N, Z, C and V are kept as the sources they come from and only become bits when read
         struct StatusRegister
         {
-            std::uint8_t c : 1; //Carry
-            std::uint8_t z : 1; //Zero
-            std::uint8_t i : 1; //Interrupt
-            std::uint8_t d : 1; //Decimal
-            std::uint8_t b : 1; //Break
-            std::uint8_t u : 1; //Unused
-            std::uint8_t v : 1; //Overflow
-            std::uint8_t n : 1; //Negative
-
-            StatusRegister() noexcept :
-                c(0), z(0), i(0), d(0),
-                b(0), u(1), v(0), n(0) {}
+            std::uint16_t c = 0; //Carry in bit 8
+            std::uint8_t i = 0; //Interrupt
+            std::uint8_t d = 0; //Decimal
+            std::uint8_t b = 0; //Break
+            std::uint8_t v = 0; //Overflow in bit 7
+            std::uint16_t nz = 1; //Zero if the low byte is 0, negative if bit 7 or 8 is set
 
             std::uint8_t operator=(const std::uint8_t value) noexcept
             {
-                c = value & (1 << 0) ? 1 : 0;
-                z = value & (1 << 1) ? 1 : 0;
+                c = static_cast<std::uint16_t>((value & (1 << 0)) << 8);
                 i = value & (1 << 2) ? 1 : 0;
                 d = value & (1 << 3) ? 1 : 0;
                 b = value & (1 << 4) ? 1 : 0;
-                v = value & (1 << 6) ? 1 : 0;
-                n = value & (1 << 7) ? 1 : 0;
+                v = static_cast<std::uint8_t>(value << 1);
+                nz = static_cast<std::uint16_t>((value & (1 << 1) ? 0 : 1) | (value & (1 << 7)) << 1);
 
                 return value;
             }
             operator std::uint8_t() const noexcept
             {
                 return
-                    n << 7 | v << 6 | u << 5 | b << 4 |
-                    d << 3 | i << 2 | z << 1 | c;
+                    negative() << 7 | overflow() << 6 | 1 << 5 | b << 4 |
+                    d << 3 | i << 2 | zero() << 1 | carry();
+            }
+            std::uint8_t carry() const noexcept
+            {
+                return (c >> 8) & 1;
             }
-            void updateNZ(std::uint8_t value) noexcept
+            bool negative() const noexcept
             {
-                n = (value & 0x80) ? 1 : 0;
-                z = (value == 0) ? 1 : 0;
+                return nz & 0x0180;
+            }
+            bool zero() const noexcept
+            {
+                return !(nz & 0x00ff);
+            }
+            bool overflow() const noexcept
+            {
+                return v & 0x80;
+            }
+            void updateNZ(const std::uint8_t value) noexcept
+            {
+                nz = value;
             }
         };
     private:
@@ -163,7 +172,7 @@ namespace fcpp::core::detail
         template<Mode mode> void SAX() noexcept;
         template<Mode mode> void SHS() noexcept;
     public:
-        void connect(Bus* bus, Clock* clock) noexcept;
+        void connect(Bus* bus, Clock* clock, Profiler* profiler) noexcept;
         template<typename Accessor> void access(Accessor& accessor) noexcept;
         void clear() noexcept;
         void exec() noexcept;
@@ -184,6 +193,7 @@ namespace fcpp::core::detail
     private:
         Bus* bus = nullptr;
         Clock* clock = nullptr;
+        Profiler* profiler = nullptr;
     private:
         static constexpr std::uint16_t NMI_VECTOR = 0xfffa;
         static constexpr std::uint16_t RESET_VECTOR = 0xfffc;
@@ -425,35 +435,35 @@ namespace fcpp::core::detail
     }
     inline void CPUImpl::BCC() noexcept
     {
-        branch(p.c == 0);
+        branch(!p.carry());
     }
     inline void CPUImpl::BCS() noexcept
     {
-        branch(p.c == 1);
+        branch(p.carry());
     }
     inline void CPUImpl::BNE() noexcept
     {
-        branch(p.z == 0);
+        branch(!p.zero());
     }
     inline void CPUImpl::BEQ() noexcept
     {
-        branch(p.z == 1);
+        branch(p.zero());
     }
     inline void CPUImpl::BPL() noexcept
     {
-        branch(p.n == 0);
+        branch(!p.negative());
     }
     inline void CPUImpl::BMI() noexcept
     {
-        branch(p.n == 1);
+        branch(p.negative());
     }
     inline void CPUImpl::BVC() noexcept
     {
-        branch(p.v == 0);
+        branch(!p.overflow());
     }
     inline void CPUImpl::BVS() noexcept
     {
-        branch(p.v == 1);
+        branch(p.overflow());
     }
     inline void CPUImpl::CLC() noexcept
     {
@@ -478,7 +488,7 @@ namespace fcpp::core::detail
     inline void CPUImpl::SEC() noexcept
     {
         I; read(pc);
-        p.c = 1;
+        p.c = 0x100;
     }
     inline void CPUImpl::SED() noexcept
     {
@@ -556,10 +566,10 @@ namespace fcpp::core::detail
     {
         std::uint16_t addr = (this->*mode)(); I;
         std::uint8_t m = read(addr);
-        std::uint16_t r = a + m + p.c;
+        std::uint16_t r = a + m + p.carry();
 
-        p.c = r > 0xff ? 1 : 0;
-        p.v = ((a ^ r) & (m ^ r) & 0x80) ? 1 : 0;
+        p.c = r;
+        p.v = static_cast<std::uint8_t>((a ^ r) & (m ^ r));
         p.updateNZ(a = static_cast<std::uint8_t>(r));
     }
     template<CPUImpl::Mode mode>
@@ -567,10 +577,10 @@ namespace fcpp::core::detail
     {
         std::uint16_t addr = (this->*mode)(); I;
         std::uint8_t m = ~read(addr);
-        std::uint16_t r = a + m + p.c;
+        std::uint16_t r = a + m + p.carry();
 
-        p.c = r > 0xff ? 1 : 0;
-        p.v = ((a ^ r) & (m ^ r) & 0x80) ? 1 : 0;
+        p.c = r;
+        p.v = static_cast<std::uint8_t>((a ^ r) & (m ^ r));
         p.updateNZ(a = static_cast<std::uint8_t>(r));
     }
     template<CPUImpl::Mode mode>
@@ -579,7 +589,7 @@ namespace fcpp::core::detail
         std::uint16_t addr = (this->*mode)(); I;
         std::uint8_t m = read(addr);
 
-        p.c = a >= m;
+        p.c = static_cast<std::uint16_t>(0x100 + a - m);
         p.updateNZ(a - m);
     }
     template<CPUImpl::Mode mode>
@@ -588,7 +598,7 @@ namespace fcpp::core::detail
         std::uint16_t addr = (this->*mode)(); I;
         std::uint8_t m = read(addr);
 
-        p.c = x >= m;
+        p.c = static_cast<std::uint16_t>(0x100 + x - m);
         p.updateNZ(x - m);
     }
     template<CPUImpl::Mode mode>
@@ -597,7 +607,7 @@ namespace fcpp::core::detail
         std::uint16_t addr = (this->*mode)(); I;
         std::uint8_t m = read(addr);
 
-        p.c = y >= m;
+        p.c = static_cast<std::uint16_t>(0x100 + y - m);
         p.updateNZ(y - m);
     }
     template<CPUImpl::Mode mode>
@@ -606,9 +616,8 @@ namespace fcpp::core::detail
         std::uint16_t addr = (this->*mode)(); I;
         std::uint8_t m = read(addr);
 
-        p.z = (a & m) == 0;
-        p.n = (m >> 7) & 1;
-        p.v = (m >> 6) & 1;
+        p.nz = static_cast<std::uint16_t>((a & m) | (m & 0x80) << 1);
+        p.v = static_cast<std::uint8_t>(m << 1);
     }
     template<CPUImpl::Mode mode>
     inline void CPUImpl::LAX() noexcept
@@ -633,7 +642,7 @@ namespace fcpp::core::detail
     {
         std::uint16_t addr = (this->*mode)(); I;
         a &= read(addr);
-        p.c = a & 0x80 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(a << 1);
         p.updateNZ(a);
     }
     template<CPUImpl::Mode mode>
@@ -641,7 +650,7 @@ namespace fcpp::core::detail
     {
         std::uint16_t addr = (this->*mode)(); I;
         a &= read(addr);
-        p.c = a & 0x01 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(a << 8);
         p.updateNZ(a >>= 1);
     }
     template<CPUImpl::Mode mode>
@@ -649,9 +658,9 @@ namespace fcpp::core::detail
     {
         std::uint16_t addr = (this->*mode)(); I;
         a &= read(addr);
-        std::uint8_t r = (a >> 1) | (p.c << 7);
-        p.c = (r >> 6) & 1;
-        p.v = ((r >> 5) & 1) ^ ((r >> 6) & 1);
+        std::uint8_t r = (a >> 1) | (p.carry() << 7);
+        p.c = static_cast<std::uint16_t>(r << 2);
+        p.v = static_cast<std::uint8_t>((r ^ (r << 1)) << 1);
         p.updateNZ(a = r);
     }
     template<CPUImpl::Mode mode>
@@ -666,7 +675,7 @@ namespace fcpp::core::detail
         std::uint16_t addr = (this->*mode)(); I;
         std::uint8_t m = read(addr);
         x &= a;
-        p.c = x >= m;
+        p.c = static_cast<std::uint16_t>(0x100 + x - m);
         p.updateNZ(x -= m);
     }
     template<CPUImpl::Mode mode>
@@ -679,30 +688,30 @@ namespace fcpp::core::detail
     inline void CPUImpl::ASL<nullptr>() noexcept
     {
         I; read(pc);
-        p.c = a & 0x80 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(a << 1);
         p.updateNZ(a <<= 1);
     }
     template<>
     inline void CPUImpl::LSR<nullptr>() noexcept
     {
         I; read(pc);
-        p.c = a & 0x01 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(a << 8);
         p.updateNZ(a >>= 1);
     }
     template<>
     inline void CPUImpl::ROL<nullptr>() noexcept
     {
         I; read(pc);
-        std::uint8_t r = (a << 1) | p.c;
-        p.c = a & 0x80 ? 1 : 0;
+        std::uint8_t r = (a << 1) | p.carry();
+        p.c = static_cast<std::uint16_t>(a << 1);
         p.updateNZ(a = r);
     }
     template<>
     inline void CPUImpl::ROR<nullptr>() noexcept
     {
         I; read(pc);
-        std::uint8_t r = (a >> 1) | (p.c << 7);
-        p.c = a & 0x01 ? 1 : 0;
+        std::uint8_t r = (a >> 1) | (p.carry() << 7);
+        p.c = static_cast<std::uint16_t>(a << 8);
         p.updateNZ(a = r);
     }
     template<CPUImpl::Mode mode>
@@ -713,7 +722,7 @@ namespace fcpp::core::detail
         write(addr, m); I;
         std::uint8_t r = m << 1;
         write(addr, r);
-        p.c = m & 0x80 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(m << 1);
         p.updateNZ(r);
     }
     template<CPUImpl::Mode mode>
@@ -724,7 +733,7 @@ namespace fcpp::core::detail
         write(addr, m); I;
         std::uint8_t r = m >> 1;
         write(addr, r);
-        p.c = m & 0x01;
+        p.c = static_cast<std::uint16_t>(m << 8);
         p.updateNZ(r);
     }
     template<CPUImpl::Mode mode>
@@ -733,9 +742,9 @@ namespace fcpp::core::detail
         std::uint16_t addr = (this->*mode)();
         std::uint8_t m = read(addr);
         write(addr, m); I;
-        std::uint8_t r = (m << 1) | p.c;
+        std::uint8_t r = (m << 1) | p.carry();
         write(addr, r);
-        p.c = m & 0x80 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(m << 1);
         p.updateNZ(r);
     }
     template<CPUImpl::Mode mode>
@@ -744,9 +753,9 @@ namespace fcpp::core::detail
         std::uint16_t addr = (this->*mode)();
         std::uint8_t m = read(addr);
         write(addr, m); I;
-        std::uint8_t r = (m >> 1) | (p.c << 7);
+        std::uint8_t r = (m >> 1) | (p.carry() << 7);
         write(addr, r);
-        p.c = m & 0x01 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(m << 8);
         p.updateNZ(r);
     }
     template<CPUImpl::Mode mode>
@@ -776,7 +785,7 @@ namespace fcpp::core::detail
         write(addr, m); I;
         std::uint8_t r = m << 1;
         write(addr, r);
-        p.c = m & 0x80 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(m << 1);
         p.updateNZ(a |= r);
     }
     template<CPUImpl::Mode mode>
@@ -788,7 +797,7 @@ namespace fcpp::core::detail
         write(addr, m); I;
         std::uint8_t r = m >> 1;
         write(addr, r);
-        p.c = m & 0x01 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(m << 8);
         p.updateNZ(a ^= r);
     }
     template<CPUImpl::Mode mode>
@@ -798,9 +807,9 @@ namespace fcpp::core::detail
         if (mode == &CPUImpl::izy<false>) read(((addr - y) & 0xff00) | ((addr) & 0x00ff));
         std::uint8_t m = read(addr);
         write(addr, m); I;
-        std::uint8_t r = (m << 1) | p.c;
+        std::uint8_t r = (m << 1) | p.carry();
         write(addr, r);
-        p.c = m & 0x80 ? 1 : 0;
+        p.c = static_cast<std::uint16_t>(m << 1);
         p.updateNZ(a &= r);
     }
     template<CPUImpl::Mode mode>
@@ -810,12 +819,12 @@ namespace fcpp::core::detail
         if (mode == &CPUImpl::izy<false>) read(((addr - y) & 0xff00) | ((addr) & 0x00ff));
         std::uint8_t m = read(addr);
         write(addr, m); I;
-        std::uint8_t r = (m >> 1) | (p.c << 7);
+        std::uint8_t r = (m >> 1) | (p.carry() << 7);
         write(addr, r);
 
         std::uint16_t r2 = a + r + (m & 0x01);
-        p.c = r2 > 0xff ? 1 : 0;
-        p.v = ((a ^ r2) & (r ^ r2) & 0x80) ? 1 : 0;
+        p.c = r2;
+        p.v = static_cast<std::uint8_t>((a ^ r2) & (r ^ r2));
         p.updateNZ(a = static_cast<std::uint8_t>(r2));
     }
     template<CPUImpl::Mode mode>
@@ -828,9 +837,9 @@ namespace fcpp::core::detail
         write(addr, ++m);
 
         m = ~m;
-        std::uint16_t r = a + m + p.c;
-        p.c = r > 0xff ? 1 : 0;
-        p.v = ((a ^ r) & (m ^ r) & 0x80) ? 1 : 0;
+        std::uint16_t r = a + m + p.carry();
+        p.c = r;
+        p.v = static_cast<std::uint8_t>((a ^ r) & (m ^ r));
         p.updateNZ(a = static_cast<std::uint8_t>(r));
     }
     template<CPUImpl::Mode mode>
@@ -841,7 +850,7 @@ namespace fcpp::core::detail
         std::uint8_t m = read(addr);
         write(addr, m); I;
         write(addr, --m);
-        p.c = a >= m;
+        p.c = static_cast<std::uint16_t>(0x100 + a - m);
         p.updateNZ(a - m);
     }
     template<CPUImpl::Mode mode>
@@ -898,10 +907,11 @@ namespace fcpp::core::detail
         write(addr, sp & ((addr >> 8) + 1));
     }
 
-    void CPUImpl::connect(Bus* const bus, Clock* const clock) noexcept
+    void CPUImpl::connect(Bus* const bus, Clock* const clock, Profiler* const profiler) noexcept
     {
         this->bus = bus;
         this->clock = clock;
+        this->profiler = profiler;
     }
     template<typename Accessor>
     inline void CPUImpl::access(Accessor& accessor) noexcept
@@ -925,14 +935,17 @@ namespace fcpp::core::detail
         if (i.detectedNMI)
         {
             i.detectedNMI = false;
+            profiler->count(Profiler::Event::NMI);
             interrupt<InterruptType::NMI>();
         }
         else if (i.detectedIRQ)
         {
             i.detectedIRQ = false;
+            profiler->count(Profiler::Event::IRQ);
             interrupt<InterruptType::IRQ>();
         }
 
+        profiler->count(Profiler::Event::Instruction);
         switch (read(pc++))
         {
         case 0x00: BRK();                       break;
@@ -1197,9 +1210,22 @@ namespace fcpp::core::detail
     inline void CPUImpl::dma(const std::uint16_t dst, const std::uint16_t src, const std::uint16_t size) noexcept
     {
         i.dmaState = CPU::State::DMA_STATE_ENABLE;
+        if constexpr (Profiler::Enabled) profiler->count(Profiler::Event::DMACycle, 2 * size + 1 + (clock->getCPUCycles() & 1));
         if (clock->getCPUCycles() & 1) T;
         T;
 
+        if (dst == 0x2004 && size == 256 && bus->copyOAM(src, 2 * size))
+        {   // nothing sees OAM before the transfer ends, only the cycles are left
+            i.tickState = CPU::State::TICK_STATE_WRITE;
+            clock->tick(2 * size - 4);
+            i.dmaState = CPU::State::DMA_STATE_SECOND_LAST_TICK;
+            T; T;
+            i.dmaState = CPU::State::DMA_STATE_LAST_TICK;
+            T; T;
+            i.dmaState = CPU::State::DMA_STATE_DISABLE;
+            return;
+        }
+
         for (std::uint16_t count = 0; count < size - 2; count++) write(dst, read(src + count));
 
         write(dst, (i.dmaState = CPU::State::DMA_STATE_SECOND_LAST_TICK, read(src + size - 2)));
@@ -1257,12 +1283,13 @@ struct fcpp::core::CPU::CPUData
 };
 
 fcpp::core::CPU::CPU() : dptr(std::make_unique<CPUData>()) {}
+fcpp::core::CPU::CPU(const CPU& other) : dptr(std::make_unique<CPUData>(*other.dptr)) {}
 fcpp::core::CPU::~CPU() noexcept = default;
 
 void fcpp::core::CPU::connect(void* const p) noexcept
 {
     auto fptr = static_cast<FC*>(p);
-    dptr->impl.connect(fptr->getBus(), fptr->getClock());
+    dptr->impl.connect(fptr->getBus(), fptr->getClock(), fptr->getProfiler());
 }
 void fcpp::core::CPU::save(void* const p) noexcept
 {
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -23,11 +25,29 @@ namespace fcpp::core::detail
 
         virtual void save(Snapshot::Writer& writer) noexcept;
         virtual void load(Snapshot::Reader& reader) noexcept;
+
+        void connect(FC* fc) noexcept;
+
+        // changes whenever the pattern tables may show other data
+        std::uint64_t getCHRVersion() const noexcept;
+        void invalidateCHR() noexcept;
+
+        virtual std::unique_ptr<Mapper> clone(INES* content) const = 0;
     protected:
+        template<typename T> std::unique_ptr<Mapper> cloneAs(INES* content) const;
+        // for registers that select CHR banks, the pattern tables only change with the value
+        void setCHRBank(std::uint8_t& bank, std::uint8_t value) noexcept;
+    protected:
+        std::uint64_t chrVersion = 1;
         INES* content = nullptr;
-        FC* fc = nullptr;
+        Clock* clock = nullptr;
+        CPU* cpu = nullptr;
+        PPU* ppu = nullptr;
     };
-    Mapper::Mapper(INES* const content, FC* const fc) : content(content), fc(fc) {}
+    Mapper::Mapper(INES* const content, FC* const fc) : content(content)
+    {
+        connect(fc);
+    }
     MirrorType Mapper::getMirrorType() noexcept
     {
         return content->getMirrorType();
@@ -38,14 +58,42 @@ namespace fcpp::core::detail
     }
     void Mapper::save(Snapshot::Writer& writer) noexcept
     {
-        if (!content->getCHRBanks()) writer.access(content->getCHRData(), content->getCHRSize());
+        if (!content->getCHRBanks()) writer.access(content->getCHRRAM(), content->getCHRSize());
         return;
     }
     void Mapper::load(Snapshot::Reader& reader) noexcept
     {
-        if (!content->getCHRBanks()) reader.access(content->getCHRData(), content->getCHRSize());
+        if (!content->getCHRBanks()) reader.access(content->getCHRRAM(), content->getCHRSize());
         return;
     }
+    void Mapper::connect(FC* const fc) noexcept
+    {
+        if (fc == nullptr) return;
+        clock = fc->getClock();
+        cpu = fc->getCPU();
+        ppu = fc->getPPU();
+    }
+    inline std::uint64_t Mapper::getCHRVersion() const noexcept
+    {
+        return chrVersion;
+    }
+    inline void Mapper::invalidateCHR() noexcept
+    {
+        chrVersion++;
+    }
+    inline void Mapper::setCHRBank(std::uint8_t& bank, const std::uint8_t value) noexcept
+    {
+        if (bank == value) return;
+        bank = value;
+        invalidateCHR();
+    }
+    template<typename T>
+    inline std::unique_ptr<Mapper> Mapper::cloneAs(INES* const content) const
+    {
+        std::unique_ptr<Mapper> mapper = std::make_unique<T>(static_cast<const T&>(*this));
+        mapper->content = content;
+        return mapper;
+    }
 
     class Mapper0 : public Mapper
     {
@@ -53,6 +101,8 @@ namespace fcpp::core::detail
         Mapper0(INES* content);
         ~Mapper0() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
 
@@ -62,6 +112,10 @@ namespace fcpp::core::detail
         std::uint8_t prgRam[0x2000]{};
     };
     Mapper0::Mapper0(INES* const content) : Mapper(content, nullptr) {}
+    std::unique_ptr<Mapper> Mapper0::clone(INES* const content) const
+    {
+        return cloneAs<Mapper0>(content);
+    }
     std::uint8_t Mapper0::readPRG(const std::uint16_t addr) noexcept
     {
         if (addr < 0x8000) return prgRam[addr & 0x1fff];
@@ -90,6 +144,8 @@ namespace fcpp::core::detail
         Mapper1(INES* content);
         ~Mapper1() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
 
@@ -110,6 +166,10 @@ namespace fcpp::core::detail
         std::uint8_t prgRam[0x2000]{};
     };
     Mapper1::Mapper1(INES* const content) : Mapper(content, nullptr) {}
+    std::unique_ptr<Mapper> Mapper1::clone(INES* const content) const
+    {
+        return cloneAs<Mapper1>(content);
+    }
     std::uint8_t Mapper1::readPRG(const std::uint16_t addr) noexcept
     {
         if (addr < 0x8000) return prgRam[addr & 0x1fff];
@@ -148,13 +208,15 @@ namespace fcpp::core::detail
                 switch ((addr >> 13) & 0x03)
                 {
                 case 0:
+                    // bit 4 switches between one 8KB and two 4KB CHR banks
+                    if ((control ^ shiftRegister) & 0x10) invalidateCHR();
                     control = shiftRegister & 0x1f;
                     break;
                 case 1:
-                    chrBank0 = shiftRegister & 0x1f;
+                    setCHRBank(chrBank0, shiftRegister & 0x1f);
                     break;
                 case 2:
-                    chrBank1 = shiftRegister & 0x1f;
+                    setCHRBank(chrBank1, shiftRegister & 0x1f);
                     break;
                 case 3:
                     prgBank = shiftRegister & 0x1f;
@@ -226,6 +288,8 @@ namespace fcpp::core::detail
         Mapper2(INES* content);
         ~Mapper2() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
 
@@ -238,6 +302,10 @@ namespace fcpp::core::detail
         std::uint8_t bankSelect = 0;
     };
     Mapper2::Mapper2(INES* const content) : Mapper(content, nullptr) {}
+    std::unique_ptr<Mapper> Mapper2::clone(INES* const content) const
+    {
+        return cloneAs<Mapper2>(content);
+    }
     std::uint8_t Mapper2::readPRG(const std::uint16_t addr) noexcept
     {
         std::uint32_t bank = 0;
@@ -275,6 +343,8 @@ namespace fcpp::core::detail
         Mapper3(INES* content);
         ~Mapper3() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
 
@@ -287,6 +357,10 @@ namespace fcpp::core::detail
         std::uint8_t bankSelect = 0;
     };
     Mapper3::Mapper3(INES* const content) : Mapper(content, nullptr) {}
+    std::unique_ptr<Mapper> Mapper3::clone(INES* const content) const
+    {
+        return cloneAs<Mapper3>(content);
+    }
     std::uint8_t Mapper3::readPRG(const std::uint16_t addr) noexcept
     {
         return
@@ -296,7 +370,7 @@ namespace fcpp::core::detail
     }
     void Mapper3::writePRG(const std::uint16_t addr, const std::uint8_t data) noexcept
     {
-        if (addr & 0x8000) bankSelect = data & 0x03;
+        if (addr & 0x8000) setCHRBank(bankSelect, data & 0x03);
     }
     std::uint8_t Mapper3::readCHR(const std::uint16_t addr) noexcept
     {
@@ -321,6 +395,8 @@ namespace fcpp::core::detail
         using Mapper::Mapper;
         ~Mapper4() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
 
@@ -344,6 +420,10 @@ namespace fcpp::core::detail
         std::uint8_t bankRegister[8]{};
         std::uint8_t prgRam[0x2000]{};
     };
+    std::unique_ptr<Mapper> Mapper4::clone(INES* const content) const
+    {
+        return cloneAs<Mapper4>(content);
+    }
     std::uint8_t Mapper4::readPRG(const std::uint16_t addr) noexcept
     {
         if (addr < 0x8000) return prgRam[addr & 0x1fff];
@@ -362,10 +442,14 @@ namespace fcpp::core::detail
         else switch (((addr >> 12) & 6) | (addr & 1))
         {
         case 0: // 0x8000
+            // bit 7 swaps the 2KB and 1KB CHR banks
+            if ((bankSelect ^ data) & 0x80) invalidateCHR();
             bankSelect = data;
             break;
         case 1: // 0x8001
-            bankRegister[bankSelect & 0x07] = data;
+            // R0-R5 select CHR banks, R6 and R7 PRG banks
+            if ((bankSelect & 0x07) < 6) setCHRBank(bankRegister[bankSelect & 0x07], data);
+            else bankRegister[bankSelect & 0x07] = data;
             break;
         case 2: // 0xa000
             mirrorType = (data & 1) ? MirrorType::HORIZONTAL : MirrorType::VERTICAL;
@@ -377,7 +461,7 @@ namespace fcpp::core::detail
             counter = 0;
             break;
         case 6: // 0xe000
-            fc->getCPU()->requestIRQ<CPU::IRQType::Mapper>(irqEnabled = false);
+            cpu->requestIRQ<CPU::IRQType::Mapper>(irqEnabled = false);
             break;
         case 7: // 0xe001
             irqEnabled = true;
@@ -421,16 +505,16 @@ namespace fcpp::core::detail
     }
     void Mapper4::sync() noexcept
     {
-        if (fc->getPPU()->get<PPU::State::Type::AddressBus>() & (1 << 12)) //A12
+        if (ppu->get<PPU::State::Type::AddressBus>() & (1 << 12)) //A12
         {
-            std::uint64_t ppuCycles = fc->getClock()->getPPUCycles();
+            std::uint64_t ppuCycles = clock->getPPUCycles();
             if (ppuCycles - ppuA12HighCycle > 16)
             {
                 //if zero or the reload flag is true, it's reloaded with the IRQ latched value at $C000; otherwise, it decrements.
                 if (counter == 0) counter = period;
                 else counter--;
                 //checks the IRQ counter transition 1 to 0, whether from decrementing or reloading.
-                if (counter == 0 && irqEnabled) fc->getCPU()->requestIRQ<CPU::IRQType::Mapper>(true);
+                if (counter == 0 && irqEnabled) cpu->requestIRQ<CPU::IRQType::Mapper>(true);
             }
             ppuA12HighCycle = ppuCycles;
         }
@@ -462,6 +546,8 @@ namespace fcpp::core::detail
         Mapper7(INES* content);
         ~Mapper7() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
 
@@ -476,6 +562,10 @@ namespace fcpp::core::detail
         std::uint8_t bankSelect = 0;
     };
     Mapper7::Mapper7(INES* const content) : Mapper(content, nullptr) {}
+    std::unique_ptr<Mapper> Mapper7::clone(INES* const content) const
+    {
+        return cloneAs<Mapper7>(content);
+    }
     std::uint8_t Mapper7::readPRG(const std::uint16_t addr) noexcept
     {
         return content->readPRG((bankSelect & 0x07) * 0x8000 + (addr & 0x7fff));
@@ -513,6 +603,8 @@ namespace fcpp::core::detail
         using Mapper::Mapper;
         ~Mapper9() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
 
@@ -525,6 +617,8 @@ namespace fcpp::core::detail
         template<typename Accessor> void access(Accessor& accessor) noexcept;
         void save(Snapshot::Writer& writer) noexcept override;
         void load(Snapshot::Reader& reader) noexcept override;
+    protected:
+        void setLatch(int idx, std::uint8_t value) noexcept;
     protected:
         MirrorType mirrorType = MirrorType::VERTICAL;
         std::uint8_t prgBankSelect = 0;
@@ -534,6 +628,10 @@ namespace fcpp::core::detail
         std::uint8_t chrBankSelect1[2]{};
         std::uint8_t prgRam[0x2000]{};
     };
+    std::unique_ptr<Mapper> Mapper9::clone(INES* const content) const
+    {
+        return cloneAs<Mapper9>(content);
+    }
     std::uint8_t Mapper9::readPRG(const std::uint16_t addr) noexcept
     {
         if (addr < 0x8000) return prgRam[addr & 0x1fff];
@@ -555,16 +653,16 @@ namespace fcpp::core::detail
             prgBankSelect = data & 0x0f;
             break;
         case 3:
-            chrBankSelect0[0] = data & 0x1f;
+            setCHRBank(chrBankSelect0[0], data & 0x1f);
             break;
         case 4:
-            chrBankSelect0[1] = data & 0x1f;
+            setCHRBank(chrBankSelect0[1], data & 0x1f);
             break;
         case 5:
-            chrBankSelect1[0] = data & 0x1f;
+            setCHRBank(chrBankSelect1[0], data & 0x1f);
             break;
         case 6:
-            chrBankSelect1[1] = data & 0x1f;
+            setCHRBank(chrBankSelect1[1], data & 0x1f);
             break;
         case 7:
             mirrorType = (data & 1) ? MirrorType::HORIZONTAL : MirrorType::VERTICAL;
@@ -586,16 +684,22 @@ namespace fcpp::core::detail
     }
     void Mapper9::sync() noexcept
     {
-        auto ppuAddr = static_cast<std::uint16_t>(fc->getPPU()->get<PPU::State::Type::AddressBus>());
+        auto ppuAddr = static_cast<std::uint16_t>(ppu->get<PPU::State::Type::AddressBus>());
         if ((ppuAddr != 0x0fd8) && (ppuAddr != 0x0fe8) && (ppuAddr < 0x1fd8 || ppuAddr > 0x1fdf) && (ppuAddr < 0x1fe8 || ppuAddr > 0x1fef))
         {
-            if (ppuReadAddr == 0x0fd8) latch[0] = 0;
-            else if (ppuReadAddr == 0x0fe8) latch[0] = 1;
-            else if (ppuReadAddr >= 0x1fd8 && ppuReadAddr <= 0x1fdf) latch[1] = 0;
-            else if (ppuReadAddr >= 0x1fe8 && ppuReadAddr <= 0x1fef) latch[1] = 1;
+            if (ppuReadAddr == 0x0fd8) setLatch(0, 0);
+            else if (ppuReadAddr == 0x0fe8) setLatch(0, 1);
+            else if (ppuReadAddr >= 0x1fd8 && ppuReadAddr <= 0x1fdf) setLatch(1, 0);
+            else if (ppuReadAddr >= 0x1fe8 && ppuReadAddr <= 0x1fef) setLatch(1, 1);
         }
         ppuReadAddr = ppuAddr;
     }
+    inline void Mapper9::setLatch(const int idx, const std::uint8_t value) noexcept
+    {   // the latches switch CHR banks
+        if (latch[idx] == value) return;
+        latch[idx] = value;
+        invalidateCHR();
+    }
     template<typename Accessor>
     inline void Mapper9::access(Accessor& accessor) noexcept
     {
@@ -622,9 +726,15 @@ namespace fcpp::core::detail
         using Mapper9::Mapper9;
         ~Mapper10() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void sync() noexcept override;
     };
+    std::unique_ptr<Mapper> Mapper10::clone(INES* const content) const
+    {
+        return cloneAs<Mapper10>(content);
+    }
     std::uint8_t Mapper10::readPRG(std::uint16_t addr) noexcept
     {
         if (addr < 0x8000) return prgRam[addr & 0x1fff];
@@ -637,14 +747,14 @@ namespace fcpp::core::detail
     }
     void Mapper10::sync() noexcept
     {
-        auto ppuAddr = static_cast<std::uint16_t>(fc->getPPU()->get<PPU::State::Type::AddressBus>());
+        auto ppuAddr = static_cast<std::uint16_t>(ppu->get<PPU::State::Type::AddressBus>());
         if ((ppuAddr < 0x0fd8 || ppuAddr > 0x0fdf) && (ppuAddr < 0x0fe8 || ppuAddr > 0x0fef) &&
             (ppuAddr < 0x1fd8 || ppuAddr > 0x1fdf) && (ppuAddr < 0x1fe8 || ppuAddr > 0x1fef))
         {
-            if (ppuReadAddr >= 0x0fd8 && ppuReadAddr <= 0x0fdf) latch[0] = 0;
-            else if (ppuReadAddr >= 0x0fe8 && ppuReadAddr <= 0x0fef) latch[0] = 1;
-            else if (ppuReadAddr >= 0x1fd8 && ppuReadAddr <= 0x1fdf) latch[1] = 0;
-            else if (ppuReadAddr >= 0x1fe8 && ppuReadAddr <= 0x1fef) latch[1] = 1;
+            if (ppuReadAddr >= 0x0fd8 && ppuReadAddr <= 0x0fdf) setLatch(0, 0);
+            else if (ppuReadAddr >= 0x0fe8 && ppuReadAddr <= 0x0fef) setLatch(0, 1);
+            else if (ppuReadAddr >= 0x1fd8 && ppuReadAddr <= 0x1fdf) setLatch(1, 0);
+            else if (ppuReadAddr >= 0x1fe8 && ppuReadAddr <= 0x1fef) setLatch(1, 1);
         }
         ppuReadAddr = ppuAddr;
     }
@@ -655,6 +765,8 @@ namespace fcpp::core::detail
         Mapper11(INES* content);
         ~Mapper11() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
 
@@ -667,13 +779,22 @@ namespace fcpp::core::detail
         std::uint8_t bankSelect = 0;
     };
     Mapper11::Mapper11(INES* const content) : Mapper(content, nullptr) {}
+    std::unique_ptr<Mapper> Mapper11::clone(INES* const content) const
+    {
+        return cloneAs<Mapper11>(content);
+    }
     std::uint8_t Mapper11::readPRG(const std::uint16_t addr) noexcept
     {
         return content->readPRG((bankSelect & 0x03) * 0x8000 + (addr & 0x7fff));
     }
     void Mapper11::writePRG(const std::uint16_t addr, const std::uint8_t data) noexcept
     {
-        if (addr & 0x8000) bankSelect = data;
+        if (addr & 0x8000)
+        {
+            // the high bits select the CHR bank
+            if ((bankSelect ^ data) & 0xf0) invalidateCHR();
+            bankSelect = data;
+        }
     }
     std::uint8_t Mapper11::readCHR(const std::uint16_t addr) noexcept
     {
@@ -697,6 +818,8 @@ namespace fcpp::core::detail
         Mapper13(INES* content);
         ~Mapper13() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         std::uint8_t readPRG(std::uint16_t addr) noexcept override;
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
 
@@ -711,13 +834,17 @@ namespace fcpp::core::detail
         std::uint8_t chrRam[0x2000]{};
     };
     Mapper13::Mapper13(INES* const content) : Mapper(content, nullptr) {}
+    std::unique_ptr<Mapper> Mapper13::clone(INES* const content) const
+    {
+        return cloneAs<Mapper13>(content);
+    }
     std::uint8_t Mapper13::readPRG(const std::uint16_t addr) noexcept
     {
         return content->readPRG(addr & 0x7fff);
     }
     void Mapper13::writePRG(const std::uint16_t addr, const std::uint8_t data) noexcept
     {
-        if (addr & 0x8000) bankSelect = data & 0x03;
+        if (addr & 0x8000) setCHRBank(bankSelect, data & 0x03);
     }
     inline std::uint32_t Mapper13::getCHRBankAddr(const std::uint16_t addr) const noexcept
     {
@@ -754,8 +881,14 @@ namespace fcpp::core::detail
         using Mapper2::Mapper2;
         ~Mapper94() override = default;
 
+        std::unique_ptr<Mapper> clone(INES* content) const override;
+
         void writePRG(std::uint16_t addr, std::uint8_t data) noexcept override;
     };
+    std::unique_ptr<Mapper> Mapper94::clone(INES* const content) const
+    {
+        return cloneAs<Mapper94>(content);
+    }
     void Mapper94::writePRG(const std::uint16_t addr, const std::uint8_t data) noexcept
     {
         if (addr & 0x8000) bankSelect = (data >> 2) & 0x07;
@@ -791,6 +924,32 @@ namespace fcpp::core::detail
             return nullptr;
         }
     }
+
+    // rows of the pattern tables as last decoded, valid while the CHR version of the mapper is unchanged
+    class PatternCache
+    {
+    public:
+        const PatternRow& get(Mapper& mapper, std::uint16_t addr) noexcept;
+        void clear() noexcept;
+    private:
+        std::uint64_t versions[0x1000]{};
+        PatternRow rows[0x1000]{};
+    };
+    inline const PatternRow& PatternCache::get(Mapper& mapper, const std::uint16_t addr) noexcept
+    {
+        auto idx = ((addr >> 1) & 0x0ff8) | (addr & 0x0007);
+        if (versions[idx] != mapper.getCHRVersion())
+        {
+            auto low = static_cast<std::uint16_t>(addr & 0x1ff7);
+            rows[idx] = decodePattern(mapper.readCHR(low), mapper.readCHR(low | 0x0008));
+            versions[idx] = mapper.getCHRVersion();
+        }
+        return rows[idx];
+    }
+    void PatternCache::clear() noexcept
+    {
+        std::fill(std::begin(versions), std::end(versions), 0);
+    }
 }
 
 bool fcpp::core::Cartridge::support(const INES& rom)
@@ -810,14 +969,22 @@ struct fcpp::core::Cartridge::CartridgeData
     FC* fc = nullptr;
     INES content{};
     std::unique_ptr<detail::Mapper> mapper{};
+    detail::PatternCache patterns{};
 };
 
 fcpp::core::Cartridge::Cartridge() : dptr(std::make_unique<CartridgeData>()) {}
+fcpp::core::Cartridge::Cartridge(const Cartridge& other) : dptr(std::make_unique<CartridgeData>())
+{
+    dptr->fc = other.dptr->fc;
+    dptr->content = other.dptr->content;
+    if (other.dptr->mapper) dptr->mapper = other.dptr->mapper->clone(&dptr->content);
+}
 fcpp::core::Cartridge::~Cartridge() noexcept = default;
 
 void fcpp::core::Cartridge::connect(void* const p) noexcept
 {
     dptr->fc = static_cast<FC*>(p);
+    if (dptr->mapper) dptr->mapper->connect(dptr->fc);
 }
 void fcpp::core::Cartridge::save(void* p) noexcept
 {
@@ -826,21 +993,25 @@ void fcpp::core::Cartridge::save(void* p) noexcept
 void fcpp::core::Cartridge::load(void* p) noexcept
 {
     dptr->mapper->load(static_cast<Snapshot*>(p)->getReader());
+    dptr->mapper->invalidateCHR();
 }
 
 bool fcpp::core::Cartridge::load(const char* const path)
 {
     if (!dptr->content.load(path)) return false;
+    dptr->patterns.clear();
     return (dptr->mapper = detail::createMapper(&dptr->content, dptr->fc)) != nullptr;
 }
 bool fcpp::core::Cartridge::load(const INES& content)
 {
     dptr->content = content;
+    dptr->patterns.clear();
     return (dptr->mapper = detail::createMapper(&dptr->content, dptr->fc)) != nullptr;
 }
 bool fcpp::core::Cartridge::load(INES&& content)
 {
     dptr->content = std::move(content);
+    dptr->patterns.clear();
     return (dptr->mapper = detail::createMapper(&dptr->content, dptr->fc)) != nullptr;
 }
 
@@ -858,7 +1029,7 @@ std::uint8_t fcpp::core::Cartridge::readPRG(const std::uint16_t addr) noexcept
     return dptr->mapper->readPRG(addr);
 }
 void fcpp::core::Cartridge::writePRG(const std::uint16_t addr, const std::uint8_t data) noexcept
-{
+{   // mappers invalidate the pattern tables themselves when a write switches CHR banks
     dptr->mapper->writePRG(addr, data);
 }
 
@@ -868,10 +1039,16 @@ std::uint8_t fcpp::core::Cartridge::readCHR(const std::uint16_t addr) noexcept
 }
 void fcpp::core::Cartridge::writeCHR(const std::uint16_t addr, const std::uint8_t data) noexcept
 {
+    dptr->mapper->invalidateCHR();
     dptr->mapper->writeCHR(addr, data);
 }
+const fcpp::core::PatternRow& fcpp::core::Cartridge::readPattern(const std::uint16_t addr) noexcept
+{
+    return dptr->patterns.get(*dptr->mapper, addr);
+}
 
 void fcpp::core::Cartridge::sync() noexcept
 {
+    if constexpr (Profiler::Enabled) dptr->fc->getProfiler()->count(Profiler::Event::MapperSync);
     dptr->mapper->sync();
 }
@@ -5,12 +5,14 @@ struct fcpp::core::Clock::ClockData
 {
     PPU* ppu = nullptr;
     APU* apu = nullptr;
+    Profiler* profiler = nullptr;
 
     std::uint64_t CPUCycles = 0;
     double fps = 60.0;
 };
 
 fcpp::core::Clock::Clock() : dptr(std::make_unique<ClockData>()) {}
+fcpp::core::Clock::Clock(const Clock& other) : dptr(std::make_unique<ClockData>(*other.dptr)) {}
 fcpp::core::Clock::~Clock() noexcept = default;
 
 void fcpp::core::Clock::connect(void* const p) noexcept
@@ -18,6 +20,7 @@ void fcpp::core::Clock::connect(void* const p) noexcept
     auto fptr = static_cast<FC*>(p);
     dptr->ppu = fptr->getPPU();
     dptr->apu = fptr->getAPU();
+    dptr->profiler = fptr->getProfiler();
 }
 void fcpp::core::Clock::save(void* const p) noexcept
 {
@@ -34,12 +37,31 @@ void fcpp::core::Clock::reset() noexcept
 
 void fcpp::core::Clock::tick() noexcept
 {
+    if constexpr (Profiler::Enabled)
+    {
+        if (dptr->profiler->sample(dptr->CPUCycles))
+        {
+            dptr->profiler->sample(Profiler::Section::PPU, [this]()
+                {
+                    dptr->ppu->exec();
+                    dptr->ppu->exec();
+                    dptr->ppu->exec();
+                });
+            dptr->profiler->sample(Profiler::Section::APU, [this]() { dptr->apu->exec(); });
+            dptr->CPUCycles++;
+            return dptr->profiler->resume();
+        }
+    }
     dptr->ppu->exec();
     dptr->ppu->exec();
     dptr->ppu->exec();
     dptr->apu->exec();
     dptr->CPUCycles++;
 }
+void fcpp::core::Clock::tick(std::uint32_t cycles) noexcept
+{
+    while (cycles--) tick();
+}
 void fcpp::core::Clock::setFrameRate(const double fps) noexcept
 {
     dptr->fps = fps > 1.0 ? fps : 1.0;
@@ -1,7 +1,62 @@
+#include <array>
 #include <cstdint>
 #include <utility>
 
 #include "FCPP/Core/FC.hpp"
+#include "FCPP/Core/Hash.hpp"
+#include "FCPP/Core/RenderThread.hpp"
+
+namespace fcpp::core::detail
+{
+    /*
+    * sits between the PPU and the frame buffer only while frame hash is enabled,
+    * the PPU draws palette indices through an identity table, so the hash does not depend on the palette of the frontend,
+    * and the hasher looks up the colors for the frame buffer
+    */
+    class FrameHasher : public FrameBuffer
+    {
+    public:
+        FrameHasher() = default;
+        ~FrameHasher() override = default;
+
+        void setPixel(int x, int y, std::uint32_t color) noexcept override;
+        void completedSignal() noexcept override;
+        const std::uint32_t* getPaletteTable() noexcept override;
+        void setFrameUnchanged(bool unchanged) noexcept override;
+    public:
+        FrameBuffer* frameBuffer = nullptr;
+        const std::uint32_t* colors = PPU::getDefaultPaletteTable();
+        std::uint64_t hash = HashSeed;
+        std::uint64_t frameHash = 0;
+    private:
+        static constexpr auto IndexTable = []() {
+            std::array<std::uint32_t, 64> table{};
+            for (std::uint32_t i = 0; i < table.size(); i++) table[i] = i;
+            return table;
+        }();
+    };
+    void FrameHasher::setPixel(const int x, const int y, const std::uint32_t color) noexcept
+    {
+        hash = hashMix(hash, color);
+        if (frameBuffer != nullptr) frameBuffer->setPixel(x, y, colors[color]);
+    }
+    void FrameHasher::completedSignal() noexcept
+    {
+        frameHash = hash;
+        hash = HashSeed;
+        if (frameBuffer != nullptr) frameBuffer->completedSignal();
+    }
+    const std::uint32_t* FrameHasher::getPaletteTable() noexcept
+    {
+        auto table = frameBuffer != nullptr ? frameBuffer->getPaletteTable() : nullptr;
+        colors = table != nullptr ? table : PPU::getDefaultPaletteTable();
+        return IndexTable.data();
+    }
+    void FrameHasher::setFrameUnchanged(const bool unchanged) noexcept
+    {   // keepsLastFrame() stays false, every pixel has to be hashed
+        if (frameBuffer != nullptr) frameBuffer->setFrameUnchanged(unchanged);
+    }
+}
 
 struct fcpp::core::FC::FCData
 {
@@ -12,6 +67,22 @@ struct fcpp::core::FC::FCData
     Bus bus{};
     Cartridge cartridge{};
     std::unique_ptr<Joypad> joypad[2]{};
+    FrameBuffer* frameBuffer = nullptr;
+    detail::FrameHasher frameHasher{};
+    bool frameHash = false;
+    std::unique_ptr<Snapshot> stateSnapshot{};
+    Profiler profiler{};
+    std::unique_ptr<RenderThread> renderThread{};
+
+    FCData() = default;
+    FCData(const FCData& other) :
+        clock(other.clock), cpu(other.cpu), ppu(other.ppu), apu(other.apu), bus(other.bus), cartridge(other.cartridge),
+        frameBuffer(other.frameBuffer), frameHasher(other.frameHasher), frameHash(other.frameHash)
+    {
+        int length = sizeof(joypad) / sizeof(joypad[0]);
+        for (int i = 0; i < length; i++) if (other.joypad[i]) joypad[i] = other.joypad[i]->clone();
+        if (frameHash) ppu.set(&frameHasher);
+    }
 
     void init(FC* const fc) noexcept
     {
@@ -32,19 +103,34 @@ fcpp::core::FC::FC(FC&& other) noexcept : dptr(std::move(other.dptr))
 {
     dptr->init(this);
 }
+fcpp::core::FC::FC(std::unique_ptr<FCData> data) noexcept : dptr(std::move(data))
+{
+    dptr->init(this);
+}
 fcpp::core::FC::~FC() noexcept = default;
 
+fcpp::core::FC fcpp::core::FC::clone() const
+{
+    return FC{ std::make_unique<FCData>(*dptr) };
+}
+
 bool fcpp::core::FC::insertCartridge(const char* const path)
 {
-    return dptr->cartridge.load(path);
+    bool ret = dptr->cartridge.load(path);
+    if (ret && dptr->renderThread) setRenderThread(true);
+    return ret;
 }
 bool fcpp::core::FC::insertCartridge(const INES& content)
 {
-    return dptr->cartridge.load(content);
+    bool ret = dptr->cartridge.load(content);
+    if (ret && dptr->renderThread) setRenderThread(true);
+    return ret;
 }
 bool fcpp::core::FC::insertCartridge(INES&& content)
 {
-    return dptr->cartridge.load(std::move(content));
+    bool ret = dptr->cartridge.load(std::move(content));
+    if (ret && dptr->renderThread) setRenderThread(true);
+    return ret;
 }
 
 void fcpp::core::FC::connect(const int idx, InputScanner* const inputScanner) noexcept
@@ -62,7 +148,8 @@ void fcpp::core::FC::connect(const int idx, InputScanner* const inputScanner) no
 }
 void fcpp::core::FC::connect(FrameBuffer* const frameBuffer) noexcept
 {
-    dptr->ppu.set(frameBuffer);
+    dptr->frameBuffer = dptr->frameHasher.frameBuffer = frameBuffer;
+    dptr->ppu.set(dptr->frameHash ? &dptr->frameHasher : frameBuffer);
 }
 void fcpp::core::FC::connect(SampleBuffer* const sampleBuffer) noexcept
 {
@@ -120,6 +207,38 @@ void fcpp::core::FC::exec() noexcept
     dptr->cpu.exec();
 }
 
+void fcpp::core::FC::setRenderThread(const bool enable)
+{   // the render thread holds a copy of the cartridge, so it is recreated for a new one
+    dptr->ppu.set(static_cast<RenderThread*>(nullptr));
+    dptr->renderThread.reset();
+    if (!enable) return;
+    dptr->renderThread = std::make_unique<RenderThread>(this);
+    dptr->ppu.set(dptr->renderThread.get());
+}
+bool fcpp::core::FC::getRenderThread() const noexcept
+{
+    return dptr->renderThread != nullptr;
+}
+
+void fcpp::core::FC::setFrameHash(const bool enable) noexcept
+{
+    dptr->frameHash = enable;
+    dptr->frameHasher.hash = detail::HashSeed;
+    dptr->frameHasher.frameHash = 0;
+    // the hasher stays valid, so it can be left in place while no frame buffer is connected
+    if (enable || dptr->frameBuffer != nullptr) dptr->ppu.set(enable ? &dptr->frameHasher : dptr->frameBuffer);
+}
+std::uint64_t fcpp::core::FC::getFrameHash() const noexcept
+{
+    return dptr->frameHash ? dptr->frameHasher.frameHash : 0;
+}
+std::uint64_t fcpp::core::FC::getStateHash() noexcept
+{
+    if (!dptr->stateSnapshot) dptr->stateSnapshot = std::make_unique<Snapshot>();
+    save(*dptr->stateSnapshot);
+    return detail::hashBlock(dptr->stateSnapshot->data(), dptr->stateSnapshot->size());
+}
+
 fcpp::core::Clock* fcpp::core::FC::getClock() noexcept
 {
     return &dptr->clock;
@@ -149,3 +268,7 @@ fcpp::core::Joypad* fcpp::core::FC::getJoypad(const int idx) noexcept
     int length = sizeof(dptr->joypad) / sizeof(dptr->joypad[0]);
     return idx < length ? dptr->joypad[idx].get() : nullptr;
 }
+fcpp::core::Profiler* fcpp::core::FC::getProfiler() noexcept
+{
+    return &dptr->profiler;
+}
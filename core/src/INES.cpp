@@ -1,7 +1,24 @@
+#include <cstring>
 #include <fstream>
-#include <iterator>
+#include <utility>
 #include <vector>
 
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   define FCPP_CORE_INES_MMAP
+#endif
+
 #include "FCPP/Core/INES.hpp"
 
 struct fcpp::core::INES::INESData
@@ -11,8 +28,114 @@ struct fcpp::core::INES::INESData
     std::uint8_t mapperType = 0;
     MirrorType mirrorType = MirrorType::VERTICAL;
 
-    std::vector<std::uint8_t> prgRom{};
-    std::vector<std::uint8_t> chrRom{};
+    // read-only rom image shared by every copy
+    std::shared_ptr<const std::uint8_t> image{};
+    bool writable = false;
+
+    std::size_t prgSize = 0;
+    std::size_t chrSize = 0;
+    const std::uint8_t* prgRom = nullptr;
+    const std::uint8_t* chrRom = nullptr;
+    // private video ram if no video rom
+    std::vector<std::uint8_t> chrRam{};
+
+    INESData() = default;
+    INESData(const INESData& other) :
+        prgBanks(other.prgBanks), chrBanks(other.chrBanks), mapperType(other.mapperType), mirrorType(other.mirrorType),
+        image(other.image), writable(other.writable),
+        prgSize(other.prgSize), chrSize(other.chrSize), prgRom(other.prgRom), chrRom(other.chrRom), chrRam(other.chrRam)
+    {
+        if (!chrRam.empty()) chrRom = chrRam.data();
+    }
+    INESData& operator=(const INESData& other)
+    {
+        if (this != &other)
+        {
+            prgBanks = other.prgBanks;
+            chrBanks = other.chrBanks;
+            mapperType = other.mapperType;
+            mirrorType = other.mirrorType;
+            image = other.image;
+            writable = other.writable;
+            prgSize = other.prgSize;
+            chrSize = other.chrSize;
+            prgRom = other.prgRom;
+            chrRom = other.chrRom;
+            chrRam = other.chrRam;
+            if (!chrRam.empty()) chrRom = chrRam.data();
+        }
+        return *this;
+    }
+
+    // validate the header in place and return the beginning of prg rom
+    const std::uint8_t* parse(const std::uint8_t* buffer, const std::size_t size) noexcept
+    {   /* reference https://wiki.nesdev.org/w/index.php?title=INES
+        *The format of the header is as follows:
+        * 0-3: Constant $4E $45 $53 $1A ("NES" followed by MS-DOS end-of-file)
+        * 4: Size of PRG ROM in 16 KB units
+        * 5: Size of CHR ROM in 8 KB units (Value 0 means the board uses CHR RAM)
+        * 6: Flags 6 - Mapper, mirroring, battery, trainer
+        * 7: Flags 7 - Mapper, VS/Playchoice, NES 2.0
+        * 8: Flags 8 - PRG-RAM size (rarely used extension)
+        * 9: Flags 9 - TV system (rarely used extension)
+        * 10: Flags 10 - TV system, PRG-RAM presence (unofficial, rarely used extension)
+        * 11-15: Unused padding (should be filled with zero, but some rippers put their name across bytes 7-15)
+        */
+
+        *this = {}; //clear data
+
+        std::size_t length = 16;
+
+        if (buffer == nullptr || size < length) return nullptr; // header = 16byte
+        if (buffer[0] != 0x4e || buffer[1] != 0x45 || buffer[2] != 0x53 || buffer[3] != 0x1a) return nullptr; //check magic number
+
+        prgBanks = buffer[4];
+        chrBanks = buffer[5];
+        mapperType = (buffer[6] >> 4) | (buffer[7] & 0xf0);
+        mirrorType = (buffer[6] & (1 << 3)) ? MirrorType::FOUR_SCREEN : (buffer[6] & 1) ? MirrorType::VERTICAL : MirrorType::HORIZONTAL;
+
+        if (buffer[6] & (1 << 2)) // trainer
+        {
+            if (size < (length += 512)) return nullptr; // header + trainer = 528byte
+            else buffer += 512; //skip trainer
+        }
+        buffer += 16;
+
+        prgSize = prgBanks * static_cast<std::size_t>(0x4000); //16kb * banks
+        chrSize = chrBanks * static_cast<std::size_t>(0x2000); //8kb * banks
+
+        if (size < (length + prgSize + chrSize)) return nullptr; // header + trainer + prgRomSize + chrRomSize
+
+        if (!chrSize) chrRam.resize(0x2000); // 8kb video ram if no video rom
+
+        return buffer;
+    }
+    // copy prg and chr rom into a new private image
+    void assign(const std::uint8_t* const prg, const std::uint8_t* const chr) noexcept
+    {
+        std::shared_ptr<std::uint8_t> buffer(new std::uint8_t[prgSize + chrSize], std::default_delete<std::uint8_t[]>());
+        if (prgSize) std::memcpy(buffer.get(), prg, prgSize);
+        if (chrSize) std::memcpy(buffer.get() + prgSize, chr, chrSize);
+
+        image = std::move(buffer);
+        writable = true;
+        prgRom = image.get();
+        chrRom = chrRam.empty() ? prgRom + prgSize : chrRam.data();
+    }
+    // use prg and chr rom in place, the image keeps them alive
+    void reference(std::shared_ptr<const std::uint8_t> buffer, const std::uint8_t* const prg) noexcept
+    {
+        image = std::move(buffer);
+        writable = false;
+        prgRom = prg;
+        chrRom = chrRam.empty() ? prgRom + prgSize : chrRam.data();
+    }
+    // rom is shared, take a private copy before the first write
+    std::uint8_t* detach() noexcept
+    {
+        if (!writable || image.use_count() != 1) assign(prgRom, chrRom);
+        return const_cast<std::uint8_t*>(prgRom);
+    }
 };
 
 fcpp::core::INES::INES() : dptr(std::make_unique<INESData>()) {}
@@ -26,59 +149,89 @@ fcpp::core::INES& fcpp::core::INES::operator=(const INES& other)
 }
 fcpp::core::INES& fcpp::core::INES::operator=(INES&&) noexcept = default;
 
-bool fcpp::core::INES::load(const char* const path)
+std::shared_ptr<const std::uint8_t> fcpp::core::INES::map(const char* const path, std::size_t& size)
 {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) return false;
-    std::vector<std::uint8_t> buffer((std::istreambuf_iterator<char>{file}), std::istreambuf_iterator<char>{});
-    return load(buffer.data(), buffer.size());
-}
-bool fcpp::core::INES::load(const std::uint8_t* buffer, const std::size_t size) noexcept
-{   /* reference https://wiki.nesdev.org/w/index.php?title=INES
-    *The format of the header is as follows:
-    * 0-3: Constant $4E $45 $53 $1A ("NES" followed by MS-DOS end-of-file)
-    * 4: Size of PRG ROM in 16 KB units
-    * 5: Size of CHR ROM in 8 KB units (Value 0 means the board uses CHR RAM)
-    * 6: Flags 6 - Mapper, mirroring, battery, trainer
-    * 7: Flags 7 - Mapper, VS/Playchoice, NES 2.0
-    * 8: Flags 8 - PRG-RAM size (rarely used extension)
-    * 9: Flags 9 - TV system (rarely used extension)
-    * 10: Flags 10 - TV system, PRG-RAM presence (unofficial, rarely used extension)
-    * 11-15: Unused padding (should be filled with zero, but some rippers put their name across bytes 7-15)
-    */
-
-    *dptr = {}; //clear data
-
-    std::size_t length = 16;
-
-    if (size < length) return false; // header = 16byte
-    if (buffer[0] != 0x4e || buffer[1] != 0x45 || buffer[2] != 0x53 || buffer[3] != 0x1a) return false; //check magic number
-
-    dptr->prgBanks = buffer[4];
-    dptr->chrBanks = buffer[5];
-    dptr->mapperType = (buffer[6] >> 4) | (buffer[7] & 0xf0);
-    dptr->mirrorType = (buffer[6] & (1 << 3)) ? MirrorType::FOUR_SCREEN : (buffer[6] & 1) ? MirrorType::VERTICAL : MirrorType::HORIZONTAL;
-
-    if (buffer[6] & (1 << 2)) // trainer
+    size = 0;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
     {
-        if (size < (length += 512)) return false; // header + trainer = 528byte
-        else buffer += 512; //skip trainer
+        LARGE_INTEGER fileSize{};
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping != nullptr)
+        {
+            auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (view != nullptr)
+            {
+                size = static_cast<std::size_t>(fileSize.QuadPart);
+                return std::shared_ptr<const std::uint8_t>(static_cast<const std::uint8_t*>(view), [](const std::uint8_t* const p) {
+                    UnmapViewOfFile(p);
+                });
+            }
+        }
     }
-    buffer += 16;
-
-    std::size_t prgRomSize = dptr->prgBanks * static_cast<std::size_t>(0x4000); //16kb * banks
-    std::size_t chrRomSize = dptr->chrBanks * static_cast<std::size_t>(0x2000); //8kb * banks
-
-    if (size < (length + prgRomSize + chrRomSize)) return false; // header + trainer + prgRomSize + chrRomSize
-
-    dptr->prgRom.assign(buffer, buffer + prgRomSize);
-    buffer += prgRomSize;
-
-    if (chrRomSize) dptr->chrRom.assign(buffer, buffer + chrRomSize);
-    else dptr->chrRom.resize(0x2000); // 8kb video ram if no video rom
+#elif defined(FCPP_CORE_INES_MMAP)
+    int fd = open(path, O_RDONLY);
+    if (fd != -1)
+    {
+        struct stat info {};
+        void* addr = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && info.st_size > 0)
+            addr = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr != MAP_FAILED)
+        {
+            std::size_t length = size = static_cast<std::size_t>(info.st_size);
+            return std::shared_ptr<const std::uint8_t>(static_cast<const std::uint8_t*>(addr), [length](const std::uint8_t* const p) {
+                munmap(const_cast<std::uint8_t*>(p), length);
+            });
+        }
+    }
+#endif
+    // fall back to a single bulk read
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return nullptr;
+    auto length = static_cast<std::streamsize>(file.tellg());
+    if (length <= 0) return nullptr;
+    std::shared_ptr<std::uint8_t> buffer(new std::uint8_t[static_cast<std::size_t>(length)], std::default_delete<std::uint8_t[]>());
+    if (!file.seekg(0).read(reinterpret_cast<char*>(buffer.get()), length)) return nullptr;
+    size = static_cast<std::size_t>(length);
+    return buffer;
+}
 
+bool fcpp::core::INES::load(const char* const path)
+{
+    std::size_t size = 0;
+    auto image = map(path, size);
+    if (!image)
+    {
+        *dptr = {};
+        return false;
+    }
+    return load(std::move(image), size);
+}
+bool fcpp::core::INES::load(const std::uint8_t* const buffer, const std::size_t size) noexcept
+{
+    auto prg = dptr->parse(buffer, size);
+    if (prg == nullptr) return false;
+    dptr->assign(prg, prg + dptr->prgSize);
     return true;
 }
+bool fcpp::core::INES::load(std::shared_ptr<const std::uint8_t> image, const std::size_t size) noexcept
+{
+    auto prg = dptr->parse(image.get(), size);
+    if (prg == nullptr) return false;
+    dptr->reference(std::move(image), prg);
+    return true;
+}
+bool fcpp::core::INES::loadView(const std::uint8_t* const buffer, const std::size_t size) noexcept
+{
+    return load(std::shared_ptr<const std::uint8_t>(buffer, [](const std::uint8_t*) {}), size);
+}
 
 std::uint8_t fcpp::core::INES::getPRGBanks() const noexcept
 {
@@ -96,21 +249,25 @@ fcpp::core::MirrorType fcpp::core::INES::getMirrorType() const noexcept
 {
     return dptr->mirrorType;
 }
-std::uint8_t* fcpp::core::INES::getPRGData() const noexcept
+const std::uint8_t* fcpp::core::INES::getPRGData() const noexcept
 {
-    return dptr->prgRom.data();
+    return dptr->prgRom;
 }
 std::size_t fcpp::core::INES::getPRGSize() const noexcept
 {
-    return dptr->prgRom.size();
+    return dptr->prgSize;
 }
-std::uint8_t* fcpp::core::INES::getCHRData() const noexcept
+const std::uint8_t* fcpp::core::INES::getCHRData() const noexcept
 {
-    return dptr->chrRom.data();
+    return dptr->chrRom;
 }
 std::size_t fcpp::core::INES::getCHRSize() const noexcept
 {
-    return dptr->chrRom.size();
+    return dptr->chrRam.empty() ? dptr->chrSize : dptr->chrRam.size();
+}
+std::uint8_t* fcpp::core::INES::getCHRRAM() noexcept
+{
+    return dptr->chrRam.empty() ? nullptr : dptr->chrRam.data();
 }
 std::uint8_t fcpp::core::INES::readPRG(const std::uint32_t addr) noexcept
 {
@@ -118,7 +275,7 @@ std::uint8_t fcpp::core::INES::readPRG(const std::uint32_t addr) noexcept
 }
 void fcpp::core::INES::writePRG(const std::uint32_t addr, const std::uint8_t data) noexcept
 {
-    dptr->prgRom[addr] = data;
+    dptr->detach()[addr] = data;
 }
 std::uint8_t fcpp::core::INES::readCHR(const std::uint32_t addr) noexcept
 {
@@ -126,5 +283,6 @@ std::uint8_t fcpp::core::INES::readCHR(const std::uint32_t addr) noexcept
 }
 void fcpp::core::INES::writeCHR(const std::uint32_t addr, const std::uint8_t data) noexcept
 {
-    dptr->chrRom[addr] = data;
+    if (!dptr->chrRam.empty()) dptr->chrRam[addr] = data;
+    else dptr->detach()[dptr->prgSize + addr] = data;
 }
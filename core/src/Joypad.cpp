@@ -37,3 +37,10 @@ std::uint8_t fcpp::core::StandardJoypad::read() noexcept
     dptr->bits = 0x80 | (dptr->bits >> 1);
     return lsb;
 }
+std::unique_ptr<fcpp::core::Joypad> fcpp::core::StandardJoypad::clone() const
+{
+    auto joypad = std::make_unique<StandardJoypad>();
+    *joypad->dptr = *dptr;
+    joypad->set(inputScanner);
+    return joypad;
+}
@@ -1,7 +1,11 @@
 #include <cstring>
+#include <vector>
 
 #include "FCPP/Core/PPU.hpp"
 #include "FCPP/Core/FC.hpp"
+#include "FCPP/Core/Hash.hpp"
+#include "FCPP/Core/Pattern.hpp"
+#include "FCPP/Core/RenderThread.hpp"
 
 namespace fcpp::core::detail
 {
@@ -182,26 +186,29 @@ namespace fcpp::core::detail
 
         struct BackgroundData
         {
-            std::uint16_t bgShiftL = 0, bgShiftH = 0;
+            std::uint32_t bgShift = 0;  // decoded pattern pixels, 2 bits each, the next pixel in the highest bits
             std::uint8_t atShiftL = 0, atShiftH = 0;
             std::uint8_t atLatchL = 0, atLatchH = 0;
-            std::uint8_t nt = 0, at = 0, bgL = 0, bgH = 0;
+            std::uint8_t nt = 0, at = 0;
+            std::uint16_t bg = 0;       // decoded pattern row, each plane is fetched on its own dot
 
             void reload() noexcept
             {
-                bgShiftL = (bgShiftL & 0xff00) | bgL;
-                bgShiftH = (bgShiftH & 0xff00) | bgH;
+                bgShift = (bgShift & 0xffff0000) | bg;
 
                 atLatchL = (at & 1) ? 1 : 0;
                 atLatchH = (at & 2) ? 1 : 0;
             }
             void shift() noexcept
             {
-                bgShiftL <<= 1;
-                bgShiftH <<= 1;
+                bgShift <<= 2;
                 atShiftL = (atShiftL << 1) | atLatchL;
                 atShiftH = (atShiftH << 1) | atLatchH;
             }
+            void fetch(const PatternRow& row, const bool high) noexcept
+            {
+                bg = high ? (bg & 0x5555) | (row.pixels & 0xaaaa) : (bg & 0xaaaa) | (row.pixels & 0x5555);
+            }
         };
 
         struct OAM
@@ -216,17 +223,70 @@ namespace fcpp::core::detail
                 std::uint8_t spL;    // Tile data (low).
                 std::uint8_t spH;    // Tile data (high).
             };
+            struct Line
+            {
+                std::uint8_t count;  // Sprites in range, only the first 16 are kept.
+                std::uint8_t ids[16];
+            };
 
             std::uint8_t mem[0x100];     // VRAM for sprite properties.
             Sprite buf[16];              // Sprite buffers.
+            std::uint16_t pixels[16]{};  // Decoded and flipped tile data of the buffers.
             std::uint8_t spCount = 0;
             std::uint8_t spLimit = 16;
+            Line lines[240]{};           // Sprites in range of each visible scanline in OAM order.
+            std::uint8_t linesHeight = 0; // Sprite height the lines were built for, 0 after a Y position changed.
 
             OAM() noexcept
             {
                 std::memset(mem, 0xff, sizeof(mem));
                 std::memset(buf, 0xff, sizeof(buf));
             }
+            void bucket(const std::uint8_t height) noexcept
+            {
+                for (auto& line : lines) line.count = 0;
+                for (int i = 0; i < 64; i++)
+                {
+                    for (int y = mem[i * 4 + 0], end = y + height; y < end && y < 240; y++)
+                    {
+                        auto& line = lines[y];
+                        if (line.count < 16) line.ids[line.count] = static_cast<std::uint8_t>(i);
+                        line.count++;
+                    }
+                }
+                linesHeight = height;
+            }
+        };
+
+        // inputs of the last frame, a frame starting from the same state with the same inputs draws the same pixels
+        struct FrameMemo
+        {
+            struct Event
+            {
+                std::uint32_t position;
+                std::uint16_t addr;
+                std::uint8_t value;
+                bool read;
+
+                bool operator==(const Event& other) const noexcept
+                {
+                    return position == other.position && addr == other.addr && value == other.value && read == other.read;
+                }
+            };
+
+            static constexpr std::size_t MaxEvents = 4096;
+            static constexpr std::uint32_t NoHit = 0xffffffff;
+
+            bool began = false;     // the current frame is tracked from its start
+            bool complete = false;  // the last frame was tracked from start to end
+            bool matching = false;  // the current frame repeats the last one so far
+            bool reusing = false;   // pixels are skipped while matching
+            bool hashed = false;    // the frame buffer keeps the last frame, so the current frame is hashed and tracked
+            std::size_t matched = 0;
+            std::uint32_t hit = NoHit, lastHit = NoHit;
+            std::uint64_t stateHash = 0;
+            std::vector<Event> events{}, lastEvents{};
+            Snapshot mapperState{};
         };
     private:
         void write(std::uint16_t addr, std::uint8_t data) noexcept;
@@ -237,14 +297,30 @@ namespace fcpp::core::detail
         void backgroundLoad() noexcept;
         void incrementAddr() noexcept;
         void draw() noexcept;
+        void spriteZeroHit() noexcept;
+        const PatternRow& readPattern(std::uint16_t addr, int planes = 1) noexcept;
+
+        std::uint32_t position() const noexcept;
+        std::uint64_t stateHash() noexcept;
+        void beginFrame() noexcept;
+        bool endFrame() noexcept;
+        void replay() noexcept;
+        void mismatch() noexcept;
+        void takeOver() noexcept;
 
         template<ScanlineType s> void cycle() noexcept;
     public:
-        void connect(Cartridge* cartridge, Bus* bus, CPU* cpu) noexcept;
+        void connect(Cartridge* cartridge, Bus* bus, CPU* cpu, Profiler* profiler) noexcept;
         void setFrameBuffer(FrameBuffer* frameBuffer) noexcept;
+        void setRenderThread(RenderThread* renderThread) noexcept;
+        void detach() noexcept;
         template<typename Accessor> void access(Accessor& accessor) noexcept;
         void clear() noexcept;
         void exec() noexcept;
+        void track(std::uint16_t addr, std::uint8_t value, bool read) noexcept;
+        void invalidate() noexcept;
+        bool idleOAM(unsigned int dots) const noexcept;
+        void writeOAM(const std::uint8_t* data) noexcept;
 
         template<PPU::Registers reg> void set(std::uint8_t v) noexcept;
         template<PPU::Registers reg> std::uint8_t get() noexcept;
@@ -266,13 +342,17 @@ namespace fcpp::core::detail
         PPUAddress vAddr{}, tAddr{};
         BackgroundData bgData{};
         OAM oam{};
+        FrameMemo memo{};
+        bool offloaded = false; // the pixels of the current frame are drawn by the render thread
     private:
         Cartridge* cartridge = nullptr;
         Bus* bus = nullptr;
         CPU* cpu = nullptr;
+        Profiler* profiler = nullptr;
         FrameBuffer* frameBuffer = nullptr;
+        RenderThread* renderThread = nullptr;
         const std::uint32_t* paletteTable = nullptr;
-    private:
+    public:
         static constexpr std::uint32_t defaultPaletteTable[64] = {
             0xff7c7c7c, 0xff0000fc, 0xff0000bc, 0xff4428bc, 0xff940084, 0xffa80020, 0xffa81000, 0xff881400,
             0xff503000, 0xff007800, 0xff006800, 0xff005800, 0xff004058, 0xff000000, 0xff000000, 0xff000000,
@@ -293,30 +373,26 @@ namespace fcpp::core::detail
     {
         return bus->read<PPU>(addr);
     }
+    inline const PatternRow& PPUImpl::readPattern(const std::uint16_t addr, const int planes) noexcept
+    {
+        profiler->count(Profiler::Event::CHR, planes);
+        return cartridge->readPattern(addr);
+    }
 
     inline void PPUImpl::spriteEvaluation() noexcept
-    {
-        oam.spCount = 0;
-        for (int i = 0; i < 64; i++)
+    {   // the lines only change with Y positions and the sprite height, other properties are read here
+        if (oam.linesHeight != ctrl.spHeight()) oam.bucket(ctrl.spHeight());
+        auto& line = oam.lines[scanline];
+        if (line.count > 8) status.o = 1; // Set by the ninth sprite in range whatever the limit is.
+        oam.spCount = line.count < oam.spLimit ? line.count : oam.spLimit;
+        for (int n = 0; n < oam.spCount; n++)
         {
-            std::uint16_t diff = scanline - oam.mem[i * 4 + 0];
-            if (diff < ctrl.spHeight())
-            {
-                if (oam.spCount == 8)
-                {
-                    status.o = 1;
-                    if (oam.spLimit == 8) break;
-                }
-                if (oam.spCount < oam.spLimit)
-                {
-                    oam.buf[oam.spCount].id = i;
-                    oam.buf[oam.spCount].y = oam.mem[i * 4 + 0];
-                    oam.buf[oam.spCount].tile = oam.mem[i * 4 + 1];
-                    oam.buf[oam.spCount].attr = oam.mem[i * 4 + 2];
-                    oam.buf[oam.spCount].x = oam.mem[i * 4 + 3];
-                    if ((++oam.spCount == oam.spLimit) && oam.spLimit > 8) break;
-                }
-            }
+            auto i = line.ids[n];
+            oam.buf[n].id = i;
+            oam.buf[n].y = oam.mem[i * 4 + 0];
+            oam.buf[n].tile = oam.mem[i * 4 + 1];
+            oam.buf[n].attr = oam.mem[i * 4 + 2];
+            oam.buf[n].x = oam.mem[i * 4 + 3];
         }
     }
     inline void PPUImpl::spriteLoad() noexcept
@@ -335,8 +411,12 @@ namespace fcpp::core::detail
                     if (oam.buf[n].attr & 0x80) spY ^= ctrl.spHeight() - 1; // Vertical flip.
                     addrBus += spY + (spY & 0x08); // Select the second tile if on 8x16.
 
-                    oam.buf[n].spL = read(addrBus);
-                    oam.buf[n].spH = read(addrBus += 8);
+                    // The pre-render line evaluates nothing and may fetch outside of the pattern tables.
+                    auto row = (addrBus & 0x3fff) < 0x2000 ? readPattern(addrBus, 2) : decodePattern(read(addrBus), read(addrBus + 8));
+                    addrBus += 8;
+                    oam.buf[n].spL = row.low;
+                    oam.buf[n].spH = row.high;
+                    oam.pixels[n] = (oam.buf[n].attr & 0x40) ? row.flipped : row.pixels; // Horizontal flip.
                 } while (dot == 317 && ++n < oam.spCount);
             }
             else if (ctrl.spHeight() == 16) addrBus = 0x1fe8;
@@ -369,13 +449,13 @@ namespace fcpp::core::detail
                 addrBus = ctrl.bgPatAddr() + (bgData.nt * 16) + vAddr.fineY;
                 break;
             case 5:
-                bgData.bgL = read(addrBus);
+                bgData.fetch(readPattern(addrBus), false);
                 break;
             case 6:
                 addrBus += 8;
                 break;
             case 7:
-                bgData.bgH = read(addrBus);
+                bgData.fetch(readPattern(addrBus), true);
                 vAddr.incH();
                 break;
             }
@@ -389,7 +469,7 @@ namespace fcpp::core::detail
         else if (dot == 256)
         {
             bgData.shift();
-            bgData.bgH = read(addrBus);
+            bgData.fetch(readPattern(addrBus), true);
         }
         else if (dot == 257)
         {
@@ -421,7 +501,7 @@ namespace fcpp::core::detail
 
             if (mask.b && !(!mask.m && x < 8))
             {
-                palette = (((bgData.bgShiftH >> (15 - fineX)) & 1) << 1) | ((bgData.bgShiftL >> (15 - fineX)) & 1);
+                palette = (bgData.bgShift >> (30 - 2 * fineX)) & 3;
                 if (palette) palette |=
                     ((((bgData.atShiftH >> (7 - fineX)) & 1) << 1) | ((bgData.atShiftL >> (7 - fineX)) & 1)) << 2;
             }
@@ -432,11 +512,14 @@ namespace fcpp::core::detail
                     std::uint16_t spX = x - oam.buf[i].x;
                     if (spX >= 8) continue; // Not in range.
 
-                    if (oam.buf[i].attr & 0x40) spX ^= 7; // Horizontal flip.
-                    spPalette = (((oam.buf[i].spH >> (7 - spX)) & 1) << 1) | ((oam.buf[i].spL >> (7 - spX)) & 1);
+                    spPalette = (oam.pixels[i] >> (14 - 2 * spX)) & 3;
                     if (spPalette == 0) continue; // Transparent pixel.
 
-                    if (oam.buf[i].id == 0 && !status.s && palette && x != 255) status.s = 1; // Sprite zero hit
+                    if (oam.buf[i].id == 0 && !status.s && palette && x != 255) // Sprite zero hit
+                    {
+                        status.s = 1;
+                        memo.hit = position();
+                    }
                     spPalette |= ((oam.buf[i].attr & 0x03) + 0x04) << 2;
                     spPriority = !(oam.buf[i].attr & 0x20);
                     break;
@@ -447,11 +530,107 @@ namespace fcpp::core::detail
         else palette = (~vAddr & 0x3f00) ? 0 : vAddr & 0x1f;
         frameBuffer->setPixel(x, scanline, paletteTable[read(0x3f00 + palette) & (mask.g ? 0x30 : 0x3f)]);
     }
+    inline void PPUImpl::spriteZeroHit() noexcept
+    {   // the only part of a pixel the CPU can see, sprite zero is always the first sprite of its line
+        const int x = dot - 2;
+        if (status.s || !oam.spCount || oam.buf[0].id != 0 || !mask.b || !mask.s || x == 255) return;
+        if (x < 8 && (!mask.m || !mask.M)) return;
+        std::uint16_t spX = x - oam.buf[0].x;
+        if (spX >= 8 || !((oam.pixels[0] >> (14 - 2 * spX)) & 3) || !((bgData.bgShift >> (30 - 2 * fineX)) & 3)) return;
+        status.s = 1;
+        memo.hit = position();
+    }
+    inline std::uint32_t PPUImpl::position() const noexcept
+    {   // dots since the start of the pre-render line
+        return (scanline == 261 ? 0 : scanline + 1) * 341 + dot;
+    }
+    inline std::uint64_t PPUImpl::stateHash() noexcept
+    {   // everything rendering reads, oddFrame only moves the timing which the event positions cover
+        std::uint64_t hash = HashSeed;
+        auto mix = [&](const std::uint64_t value) { hash = hashMix(hash, value); };
+        mix(static_cast<std::uint8_t>(ctrl));
+        mix(static_cast<std::uint8_t>(mask));
+        mix(static_cast<std::uint16_t>(vAddr));
+        mix(static_cast<std::uint16_t>(tAddr));
+        mix(fineX);
+        mix(latch);
+        mix(oamAddr);
+        mix(updateAddrDelay);
+        mix(addrBus);
+        mix(bgData.bgShift);
+        mix(bgData.atShiftL << 24 | bgData.atShiftH << 16 | bgData.atLatchL << 8 | bgData.atLatchH);
+        mix(bgData.nt << 24 | bgData.at << 16 | bgData.bg);
+        mix(oam.spCount);
+        mix(oam.spLimit);
+        mix(static_cast<std::uint64_t>(cartridge->getMirrorType()));
+        mix(hashBlock(oam.mem, sizeof(oam.mem)));
+        mix(hashBlock(reinterpret_cast<const std::uint8_t*>(oam.buf), sizeof(oam.buf)));
+        mix(hashBlock(bus->dump<Bus::MemoryType::VRAM>(), 0x1000));
+        mix(hashBlock(bus->dump<Bus::MemoryType::PRAM>(), 0x20));
+        mix(hashBlock(reinterpret_cast<const std::uint8_t*>(paletteTable), 64 * sizeof(std::uint32_t)));
+        // banks and CHR RAM, conservative for mappers that keep PRG RAM as well
+        memo.mapperState.rewindWriter();
+        cartridge->save(&memo.mapperState);
+        mix(hashBlock(memo.mapperState.data(), memo.mapperState.size()));
+        return hash;
+    }
+    inline void PPUImpl::beginFrame() noexcept
+    {   // a frame buffer that does not keep the last frame needs every pixel, so there is nothing to compare
+        auto keeps = frameBuffer->keepsLastFrame();
+        auto hash = keeps ? stateHash() : 0;
+        memo.matching = keeps && memo.hashed && memo.complete && hash == memo.stateHash;
+        memo.reusing = memo.matching;
+        memo.hashed = keeps;
+        memo.began = true;
+        memo.complete = false;
+        memo.matched = 0;
+        memo.stateHash = hash;
+        memo.lastHit = memo.hit;
+        memo.hit = FrameMemo::NoHit;
+        memo.lastEvents.swap(memo.events);
+        memo.events.clear();
+        offloaded = renderThread != nullptr && !memo.reusing && renderThread->begin(frameBuffer, oam.spLimit);
+    }
+    inline bool PPUImpl::endFrame() noexcept
+    {
+        bool unchanged = memo.began && memo.matching && memo.matched == memo.lastEvents.size();
+        memo.complete = memo.began && memo.events.size() < FrameMemo::MaxEvents;
+        memo.began = memo.matching = memo.reusing = false;
+        return unchanged;
+    }
+    inline void PPUImpl::replay() noexcept
+    {   // the last frame drew the same pixel here, only the sprite zero hit has to happen again
+        auto pos = position();
+        if (memo.matched < memo.lastEvents.size() && memo.lastEvents[memo.matched].position <= pos)
+        {   // an input of the last frame is missing this time
+            mismatch();
+            return draw();
+        }
+        if (pos == memo.lastHit)
+        {
+            status.s = 1;
+            memo.hit = pos;
+        }
+    }
+    inline void PPUImpl::mismatch() noexcept
+    {
+        memo.matching = memo.reusing = false;
+    }
+    inline void PPUImpl::takeOver() noexcept
+    {
+        renderThread->finish(position());
+        offloaded = false;
+    }
 
     template<> // reference https://www.nesdev.org/wiki/PPU_rendering
     inline void PPUImpl::cycle<PPUImpl::ScanlineType::VISIBLE>() noexcept
     {
-        if (dot >= 2 && dot <= 257) draw();
+        if (dot >= 2 && dot <= 257)
+        {
+            if (memo.reusing) replay();
+            else if (offloaded) spriteZeroHit();
+            else draw();
+        }
         if (mask.rendering())
         {
             backgroundLoad();
@@ -462,7 +641,12 @@ namespace fcpp::core::detail
     template<>
     inline void PPUImpl::cycle<PPUImpl::ScanlineType::POST>() noexcept
     {
-        if (dot == 0) frameBuffer->completedSignal();
+        if (dot == 0)
+        {
+            if (offloaded) profiler->measure(Profiler::Section::Output, [this]() { takeOver(); });
+            frameBuffer->setFrameUnchanged(endFrame());
+            profiler->measure(Profiler::Section::Output, [this]() { frameBuffer->completedSignal(); });
+        }
     }
     template<>
     inline void PPUImpl::cycle<PPUImpl::ScanlineType::NMI>() noexcept
@@ -476,7 +660,8 @@ namespace fcpp::core::detail
     template<>
     inline void PPUImpl::cycle<PPUImpl::ScanlineType::PRE>() noexcept
     {
-        if (dot == 2) status.o = status.s = status.v = 0;
+        if (dot == 0) beginFrame();
+        else if (dot == 2) status.o = status.s = status.v = 0;
         if (mask.rendering())
         {
             backgroundLoad();
@@ -486,17 +671,29 @@ namespace fcpp::core::detail
         }
     }
 
-    void PPUImpl::connect(Cartridge* const cartridge, Bus* const bus, CPU* const cpu) noexcept
+    void PPUImpl::connect(Cartridge* const cartridge, Bus* const bus, CPU* const cpu, Profiler* const profiler) noexcept
     {
         this->cartridge = cartridge;
         this->bus = bus;
         this->cpu = cpu;
+        this->profiler = profiler;
+    }
+    void PPUImpl::setRenderThread(RenderThread* const renderThread) noexcept
+    {
+        if (offloaded) takeOver();
+        this->renderThread = renderThread;
+    }
+    void PPUImpl::detach() noexcept
+    {   // a copy draws its own frames, the current one from where it was copied
+        renderThread = nullptr;
+        offloaded = false;
     }
     void PPUImpl::setFrameBuffer(FrameBuffer* const frameBuffer) noexcept
     {
         this->frameBuffer = frameBuffer;
         auto externalPaletteTable = frameBuffer->getPaletteTable();
         this->paletteTable = (externalPaletteTable == nullptr) ? defaultPaletteTable : externalPaletteTable;
+        invalidate();
     }
     template<typename Accessor>
     inline void PPUImpl::access(Accessor& accessor) noexcept
@@ -515,19 +712,30 @@ namespace fcpp::core::detail
         accessor.access(dataBuffer);
         accessor.access(updateAddrDelay);
         accessor.access(addrBus);
-        accessor.access(bgData.bgShiftL);
-        accessor.access(bgData.bgShiftH);
+        // pattern data is kept as bit planes in snapshots
+        std::uint16_t bgShiftL = gatherPlane(bgData.bgShift), bgShiftH = gatherPlane(bgData.bgShift >> 1);
+        std::uint8_t bgL = static_cast<std::uint8_t>(gatherPlane(bgData.bg)), bgH = static_cast<std::uint8_t>(gatherPlane(bgData.bg >> 1));
+        accessor.access(bgShiftL);
+        accessor.access(bgShiftH);
         accessor.access(bgData.atShiftL);
         accessor.access(bgData.atShiftH);
         accessor.access(bgData.atLatchL);
         accessor.access(bgData.atLatchH);
         accessor.access(bgData.nt);
         accessor.access(bgData.at);
-        accessor.access(bgData.bgL);
-        accessor.access(bgData.bgH);
+        accessor.access(bgL);
+        accessor.access(bgH);
         accessor.access(oam.spCount);
         accessor.access(oam.buf, sizeof(oam.buf));
         accessor.access(oam.mem, sizeof(oam.mem));
+        oam.linesHeight = 0;
+        bgData.bgShift = spreadPlane(bgShiftH) << 1 | spreadPlane(bgShiftL);
+        bgData.bg = static_cast<std::uint16_t>(spreadPlane(bgH) << 1 | spreadPlane(bgL));
+        for (int i = 0; i < 16; i++)
+        {
+            auto row = decodePattern(oam.buf[i].spL, oam.buf[i].spH);
+            oam.pixels[i] = (oam.buf[i].attr & 0x40) ? row.flipped : row.pixels;
+        }
     }
     inline void PPUImpl::clear() noexcept
     {
@@ -537,6 +745,32 @@ namespace fcpp::core::detail
         mask = {};
         status = {};
         bgData = {};
+        invalidate();
+    }
+    inline void PPUImpl::track(const std::uint16_t addr, const std::uint8_t value, const bool read) noexcept
+    {   // inputs between frames are covered by the state hash of the next frame
+        if (!memo.began) return;
+        FrameMemo::Event event{ position(), addr, value, read };
+        if (offloaded && !renderThread->push(event.position, addr, value, read)) takeOver();
+        if (!memo.hashed) return;
+        if (memo.events.size() == FrameMemo::MaxEvents) return mismatch();
+        memo.events.push_back(event);
+        if (memo.matching && !(memo.matched < memo.lastEvents.size() && memo.lastEvents[memo.matched++] == event)) mismatch();
+    }
+    inline void PPUImpl::invalidate() noexcept
+    {
+        if (offloaded) takeOver();
+        memo.began = memo.complete = memo.matching = memo.reusing = false;
+    }
+    inline bool PPUImpl::idleOAM(const unsigned int dots) const noexcept
+    {   // from the end of a frame to the pre-render line OAM is neither evaluated nor tracked
+        return !memo.began && scanline >= 240 && scanline < 261 && (261u - scanline) * 341u - dot > dots;
+    }
+    inline void PPUImpl::writeOAM(const std::uint8_t* const data) noexcept
+    {   // same as 256 writes to OAMDATA, which leave OAMADDR where it was
+        std::memcpy(oam.mem + oamAddr, data, 0x100 - oamAddr);
+        std::memcpy(oam.mem, data + 0x100 - oamAddr, oamAddr);
+        oam.linesHeight = 0;
     }
     inline void PPUImpl::exec() noexcept
     {
@@ -556,6 +790,7 @@ namespace fcpp::core::detail
                 scanline = 0;
                 oddFrame = !oddFrame;
             }
+            if (offloaded) renderThread->publish(position());
         }
     }
 
@@ -576,6 +811,7 @@ namespace fcpp::core::detail
     }
     template<> inline void PPUImpl::set<PPU::Registers::OAMDATA>(const std::uint8_t v) noexcept
     {
+        if (!(oamAddr & 0x03)) oam.linesHeight = 0;
         oam.mem[oamAddr++] = v;
     }
     template<> inline void PPUImpl::set<PPU::Registers::PPUSCROLL>(const std::uint8_t v) noexcept
@@ -642,11 +878,16 @@ namespace fcpp::core::detail
     template<> inline void PPUImpl::set<PPU::State::Type::SpriteLimit>(const unsigned int v) noexcept
     {
         oam.spLimit = v < 8 ? 8 : (16 < v ? 16 : v);
+        invalidate();
     }
     template<> inline unsigned int PPUImpl::get<PPU::State::Type::SpriteLimit>() const noexcept
     {
         return oam.spLimit;
     }
+    template<> inline unsigned int PPUImpl::get<PPU::State::Type::Position>() const noexcept
+    {
+        return position();
+    }
     template<> inline unsigned int PPUImpl::get<PPU::State::Type::AddressBus>() const noexcept
     { // A0-A13 are not tristated and output the contents of the V register whenever rendering is disabled.
         return (mask.rendering() ? addrBus : vAddr) & 0x3fff;
@@ -659,13 +900,22 @@ struct fcpp::core::PPU::PPUData
     std::uint8_t openBusData = 0;
 };
 
+const std::uint32_t* fcpp::core::PPU::getDefaultPaletteTable() noexcept
+{
+    return detail::PPUImpl::defaultPaletteTable;
+}
+
 fcpp::core::PPU::PPU() : dptr(std::make_unique<PPUData>()) {}
+fcpp::core::PPU::PPU(const PPU& other) : dptr(std::make_unique<PPUData>(*other.dptr))
+{
+    dptr->impl.detach();
+}
 fcpp::core::PPU::~PPU() noexcept = default;
 
 void fcpp::core::PPU::connect(void* const p) noexcept
 {
     auto fptr = static_cast<FC*>(p);
-    dptr->impl.connect(fptr->getCartridge(), fptr->getBus(), fptr->getCPU());
+    dptr->impl.connect(fptr->getCartridge(), fptr->getBus(), fptr->getCPU(), fptr->getProfiler());
 }
 void fcpp::core::PPU::save(void* const p) noexcept
 {
@@ -676,6 +926,7 @@ void fcpp::core::PPU::save(void* const p) noexcept
 void fcpp::core::PPU::load(void* const p) noexcept
 {
     auto& reader = static_cast<Snapshot*>(p)->getReader();
+    dptr->impl.invalidate();
     reader.access(dptr->openBusData);
     dptr->impl.access(reader);
 }
@@ -689,10 +940,24 @@ void fcpp::core::PPU::exec() noexcept
 {
     dptr->impl.exec();
 }
+void fcpp::core::PPU::track(const std::uint16_t addr, const std::uint8_t data) noexcept
+{
+    dptr->impl.track(addr, data, false);
+}
+bool fcpp::core::PPU::idleOAM(const unsigned int dots) const noexcept
+{
+    return dptr->impl.idleOAM(dots);
+}
+void fcpp::core::PPU::writeOAM(const std::uint8_t* const data) noexcept
+{
+    dptr->openBusData = data[0xff];
+    dptr->impl.writeOAM(data);
+}
 
 template<>
 std::uint8_t fcpp::core::PPU::get<fcpp::core::PPU::Registers::PPUSTATUS>() noexcept
 {
+    dptr->impl.track(0x2002, 0, true);
     return dptr->openBusData = dptr->impl.get<Registers::PPUSTATUS>() | (dptr->openBusData & 0x1f);
 }
 template<>
@@ -703,6 +968,7 @@ std::uint8_t fcpp::core::PPU::get<fcpp::core::PPU::Registers::OAMDATA>() noexcep
 template<>
 std::uint8_t fcpp::core::PPU::get<fcpp::core::PPU::Registers::PPUDATA>() noexcept
 {
+    dptr->impl.track(0x2007, 0, true);
     return dptr->openBusData = dptr->impl.get<Registers::PPUDATA>();
 }
 template<fcpp::core::PPU::Registers reg>
@@ -718,6 +984,7 @@ void fcpp::core::PPU::set<fcpp::core::PPU::Registers::PPUSTATUS>(const std::uint
 template<fcpp::core::PPU::Registers reg>
 void fcpp::core::PPU::set(const std::uint8_t v) noexcept
 {
+    dptr->impl.track(0x2000 + static_cast<std::uint16_t>(reg), v, false);
     dptr->impl.set<reg>(dptr->openBusData = v);
 }
 template<fcpp::core::PPU::State::Type type>
@@ -734,6 +1001,10 @@ void fcpp::core::PPU::set(FrameBuffer* const frameBuffer) noexcept
 {
     dptr->impl.setFrameBuffer(frameBuffer);
 }
+void fcpp::core::PPU::set(RenderThread* const renderThread) noexcept
+{
+    dptr->impl.setRenderThread(renderThread);
+}
 
 template std::uint8_t fcpp::core::PPU::get<fcpp::core::PPU::Registers::PPUCTRL>() noexcept;
 template std::uint8_t fcpp::core::PPU::get<fcpp::core::PPU::Registers::PPUMASK>() noexcept;
@@ -749,4 +1020,5 @@ template void fcpp::core::PPU::set<fcpp::core::PPU::Registers::PPUADDR>(const st
 template void fcpp::core::PPU::set<fcpp::core::PPU::Registers::PPUDATA>(const std::uint8_t) noexcept;
 template unsigned int fcpp::core::PPU::get<fcpp::core::PPU::State::Type::SpriteLimit>() const noexcept;
 template unsigned int fcpp::core::PPU::get<fcpp::core::PPU::State::Type::AddressBus>() const noexcept;
+template unsigned int fcpp::core::PPU::get<fcpp::core::PPU::State::Type::Position>() const noexcept;
 template void fcpp::core::PPU::set<fcpp::core::PPU::State::Type::SpriteLimit>(const unsigned int) noexcept;
@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FCPP/Core/ROMPack.hpp"
+
+/*
+* Layout, all integers are little-endian:
+* 0-3: Constant "FCPK"
+* 4-11: Entry count
+* Index, for each entry: name size (8 bytes), name, data offset from file begin (8 bytes), data size (8 bytes)
+* Data of every entry
+*/
+namespace fcpp::core::detail
+{
+    static constexpr char ROMPackMagic[] = { 'F', 'C', 'P', 'K' };
+
+    inline static bool readInteger(const std::uint8_t*& data, const std::uint8_t* const end, std::uint64_t& value) noexcept
+    {
+        if (static_cast<std::size_t>(end - data) < 8) return false;
+        value = 0;
+        for (int i = 0; i < 8; i++) value |= static_cast<std::uint64_t>(*data++) << (8 * i);
+        return true;
+    }
+    inline static void writeInteger(std::vector<char>& buffer, const std::uint64_t value)
+    {
+        for (int i = 0; i < 8; i++) buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+struct fcpp::core::ROMPack::ROMPackData
+{
+    struct Entry
+    {
+        std::string name;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    std::shared_ptr<const std::uint8_t> image{};
+    std::vector<Entry> entries{};
+};
+
+bool fcpp::core::ROMPack::create(const char* const path, const char* const* const files, const std::size_t count)
+{
+    std::vector<std::string> names(count);
+    std::vector<std::vector<char>> contents(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        std::ifstream file(files[i], std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+        auto length = static_cast<std::streamsize>(file.tellg());
+        if (length < 0) return false;
+        contents[i].resize(static_cast<std::size_t>(length));
+        if (!file.seekg(0).read(contents[i].data(), length)) return false;
+
+        std::string name = files[i];
+        auto pos = name.find_last_of("/\\");
+        names[i] = pos == std::string::npos ? name : name.substr(pos + 1);
+    }
+
+    std::size_t offset = sizeof(detail::ROMPackMagic) + 8;
+    for (auto& name : names) offset += 8 + name.size() + 8 + 8;
+
+    std::vector<char> index(detail::ROMPackMagic, detail::ROMPackMagic + sizeof(detail::ROMPackMagic));
+    detail::writeInteger(index, count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        detail::writeInteger(index, names[i].size());
+        index.insert(index.end(), names[i].begin(), names[i].end());
+        detail::writeInteger(index, offset);
+        detail::writeInteger(index, contents[i].size());
+        offset += contents[i].size();
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    if (!file.write(index.data(), static_cast<std::streamsize>(index.size()))) return false;
+    for (auto& content : contents)
+        if (!file.write(content.data(), static_cast<std::streamsize>(content.size()))) return false;
+    return true;
+}
+
+fcpp::core::ROMPack::ROMPack() : dptr(std::make_unique<ROMPackData>()) {}
+fcpp::core::ROMPack::ROMPack(ROMPack&&) noexcept = default;
+fcpp::core::ROMPack::~ROMPack() noexcept = default;
+fcpp::core::ROMPack& fcpp::core::ROMPack::operator=(ROMPack&&) noexcept = default;
+
+bool fcpp::core::ROMPack::open(const char* const path)
+{
+    *dptr = {};
+
+    std::size_t size = 0;
+    auto image = INES::map(path, size);
+    if (!image) return false;
+
+    auto data = image.get();
+    auto end = data + size;
+    if (size < sizeof(detail::ROMPackMagic) || std::memcmp(data, detail::ROMPackMagic, sizeof(detail::ROMPackMagic))) return false;
+    data += sizeof(detail::ROMPackMagic);
+
+    std::uint64_t count = 0;
+    if (!detail::readInteger(data, end, count)) return false;
+
+    std::vector<ROMPackData::Entry> entries{};
+    for (std::uint64_t i = 0; i < count; i++)
+    {
+        std::uint64_t nameSize = 0, offset = 0, length = 0;
+        if (!detail::readInteger(data, end, nameSize) || static_cast<std::uint64_t>(end - data) < nameSize) return false;
+        std::string name(reinterpret_cast<const char*>(data), static_cast<std::size_t>(nameSize));
+        data += nameSize;
+        if (!detail::readInteger(data, end, offset) || !detail::readInteger(data, end, length)) return false;
+        if (offset > size || length > size - offset) return false;
+        entries.push_back({ std::move(name), static_cast<std::size_t>(offset), static_cast<std::size_t>(length) });
+    }
+
+    dptr->image = std::move(image);
+    dptr->entries = std::move(entries);
+    return true;
+}
+
+std::size_t fcpp::core::ROMPack::count() const noexcept
+{
+    return dptr->entries.size();
+}
+const char* fcpp::core::ROMPack::name(const std::size_t idx) const noexcept
+{
+    return idx < dptr->entries.size() ? dptr->entries[idx].name.c_str() : nullptr;
+}
+
+bool fcpp::core::ROMPack::load(const std::size_t idx, INES& rom) const noexcept
+{
+    if (idx >= dptr->entries.size()) return false;
+    auto& entry = dptr->entries[idx];
+    // aliasing constructor, the rom keeps the whole archive mapped
+    return rom.load(std::shared_ptr<const std::uint8_t>(dptr->image, dptr->image.get() + entry.offset), entry.size);
+}
+bool fcpp::core::ROMPack::load(const char* const name, INES& rom) const noexcept
+{
+    for (std::size_t i = 0; i < dptr->entries.size(); i++)
+        if (dptr->entries[i].name == name) return load(i, rom);
+    return false;
+}
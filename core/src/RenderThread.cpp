@@ -0,0 +1,143 @@
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "FCPP/Core/FC.hpp"
+#include "FCPP/Core/RenderThread.hpp"
+
+struct fcpp::core::RenderThread::RenderThreadData
+{
+    struct Event
+    {
+        std::uint32_t position;
+        std::uint16_t addr;
+        std::uint8_t value;
+        bool read;
+    };
+
+    PPU* ppu = nullptr;
+    Bus* bus = nullptr;
+    Cartridge* cartridge = nullptr;
+    FC machine;
+
+    Snapshot state{};
+    FrameBuffer* frameBuffer = nullptr;
+    unsigned int spriteLimit = 8;
+    Event events[MaxEvents]{};
+
+    std::atomic<std::size_t> count{ 0 };
+    std::atomic<std::uint32_t> limit{ 0 };
+    std::atomic<bool> last{ false };
+    std::atomic<bool> idle{ true };
+
+    std::mutex mutex{};
+    std::condition_variable condition{};
+    std::uint64_t frames = 0;
+    bool quit = false;
+    std::thread thread{};
+
+    explicit RenderThreadData(FC* const fc) :
+        ppu(fc->getPPU()), bus(fc->getBus()), cartridge(fc->getCartridge()), machine(fc->clone()) {}
+
+    void run() noexcept
+    {
+        for (std::uint64_t frame = 0;;)
+        {
+            {
+                std::unique_lock lock{ mutex };
+                condition.wait(lock, [&]() { return quit || frames != frame; });
+                if (quit) return;
+                frame = frames;
+            }
+            render();
+            idle.store(true, std::memory_order_release);
+        }
+    }
+    void render() noexcept
+    {
+        auto target = machine.getPPU();
+        auto targetBus = machine.getBus();
+        state.rewindReader();
+        target->load(&state);
+        targetBus->load(&state);
+        machine.getCartridge()->load(&state);
+        target->set(frameBuffer);
+        target->set<PPU::State::Type::SpriteLimit>(spriteLimit);
+
+        std::size_t next = 0;
+        for (auto position = target->get<PPU::State::Type::Position>();;)
+        {   // the limit is read before the log, so every input before it is visible
+            bool done = last.load(std::memory_order_acquire);
+            if (position >= limit.load(std::memory_order_acquire))
+            {
+                if (done) return;
+                std::this_thread::yield();
+                continue;
+            }
+            for (auto size = count.load(std::memory_order_acquire); next < size && events[next].position <= position; next++)
+            {
+                auto& event = events[next];
+                if (event.read) targetBus->read<CPU>(event.addr);
+                else targetBus->write<CPU>(event.addr, event.value);
+            }
+            target->exec();
+            position = target->get<PPU::State::Type::Position>();
+        }
+    }
+};
+
+fcpp::core::RenderThread::RenderThread(FC* const fc) : dptr(std::make_unique<RenderThreadData>(fc))
+{
+    dptr->thread = std::thread{ [this]() { dptr->run(); } };
+}
+fcpp::core::RenderThread::~RenderThread() noexcept
+{
+    dptr->last.store(true, std::memory_order_release);
+    {
+        std::lock_guard lock{ dptr->mutex };
+        dptr->quit = true;
+    }
+    dptr->condition.notify_one();
+    dptr->thread.join();
+}
+
+bool fcpp::core::RenderThread::begin(FrameBuffer* const frameBuffer, const unsigned int spriteLimit) noexcept
+{
+    if (!dptr->idle.load(std::memory_order_acquire)) return false;
+
+    dptr->state.rewindWriter();
+    dptr->ppu->save(&dptr->state);
+    dptr->bus->save(&dptr->state);
+    dptr->cartridge->save(&dptr->state);
+    dptr->frameBuffer = frameBuffer;
+    dptr->spriteLimit = spriteLimit;
+    dptr->count.store(0, std::memory_order_relaxed);
+    dptr->limit.store(0, std::memory_order_relaxed);
+    dptr->last.store(false, std::memory_order_relaxed);
+    dptr->idle.store(false, std::memory_order_relaxed);
+    {
+        std::lock_guard lock{ dptr->mutex };
+        dptr->frames++;
+    }
+    dptr->condition.notify_one();
+    return true;
+}
+bool fcpp::core::RenderThread::push(const std::uint32_t position, const std::uint16_t addr, const std::uint8_t value, const bool read) noexcept
+{
+    auto size = dptr->count.load(std::memory_order_relaxed);
+    if (size == MaxEvents) return false;
+    dptr->events[size] = { position, addr, value, read };
+    dptr->count.store(size + 1, std::memory_order_release);
+    return true;
+}
+void fcpp::core::RenderThread::publish(const std::uint32_t position) noexcept
+{
+    dptr->limit.store(position, std::memory_order_release);
+}
+void fcpp::core::RenderThread::finish(const std::uint32_t position) noexcept
+{
+    dptr->limit.store(position, std::memory_order_release);
+    dptr->last.store(true, std::memory_order_release);
+    while (!dptr->idle.load(std::memory_order_acquire)) std::this_thread::yield();
+}
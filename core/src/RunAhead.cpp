@@ -0,0 +1,126 @@
+#include "FCPP/Core/RunAhead.hpp"
+
+namespace fcpp::core::detail
+{
+    class RunAheadOutput :
+        public FrameBuffer,
+        public SampleBuffer
+    {
+    public:
+        RunAheadOutput() = default;
+        ~RunAheadOutput() override = default;
+
+        void setPixel(int x, int y, std::uint32_t color) noexcept override;
+        void completedSignal() noexcept override;
+        const std::uint32_t* getPaletteTable() noexcept override;
+        bool keepsLastFrame() noexcept override;
+        void setFrameUnchanged(bool unchanged) noexcept override;
+
+        void sendSample(double sample) noexcept override;
+        int getSampleRate() noexcept override;
+    public:
+        FrameBuffer* frameBuffer = nullptr;
+        SampleBuffer* sampleBuffer = nullptr;
+        // shown: the last frame went to the frame buffer
+        bool video = true, audio = true, completed = false, shown = false;
+    };
+    void RunAheadOutput::setPixel(const int x, const int y, const std::uint32_t color) noexcept
+    {
+        if (video && frameBuffer != nullptr) frameBuffer->setPixel(x, y, color);
+    }
+    void RunAheadOutput::completedSignal() noexcept
+    {
+        completed = true;
+        shown = video;
+        if (video && frameBuffer != nullptr) frameBuffer->completedSignal();
+    }
+    const std::uint32_t* RunAheadOutput::getPaletteTable() noexcept
+    {
+        return frameBuffer != nullptr ? frameBuffer->getPaletteTable() : nullptr;
+    }
+    bool RunAheadOutput::keepsLastFrame() noexcept
+    {
+        // frames run ahead are not shown, so the buffer only holds the last frame if it was shown too
+        return !video || frameBuffer == nullptr || (shown && frameBuffer->keepsLastFrame());
+    }
+    void RunAheadOutput::setFrameUnchanged(const bool unchanged) noexcept
+    {
+        if (video && frameBuffer != nullptr) frameBuffer->setFrameUnchanged(unchanged && shown);
+    }
+    void RunAheadOutput::sendSample(const double sample) noexcept
+    {
+        if (audio && sampleBuffer != nullptr) sampleBuffer->sendSample(sample);
+    }
+    int RunAheadOutput::getSampleRate() noexcept
+    {
+        return sampleBuffer != nullptr ? sampleBuffer->getSampleRate() : 44100;
+    }
+}
+
+struct fcpp::core::RunAhead::RunAheadData
+{
+    FC* fc = nullptr;
+    std::unique_ptr<FC> second{};
+    int frames = 0;
+    Snapshot snapshot{};
+    detail::RunAheadOutput output{};
+
+    void run(FC& target, const bool video, const bool audio) noexcept
+    {
+        output.video = video;
+        output.audio = audio;
+        output.completed = false;
+        while (!output.completed) target.exec();
+    }
+};
+
+fcpp::core::RunAhead::RunAhead(FC* const fc) : dptr(std::make_unique<RunAheadData>())
+{
+    dptr->fc = fc;
+    dptr->fc->connect(static_cast<FrameBuffer*>(&dptr->output));
+    dptr->fc->connect(static_cast<SampleBuffer*>(&dptr->output));
+}
+fcpp::core::RunAhead::~RunAhead() noexcept = default;
+
+void fcpp::core::RunAhead::connect(FrameBuffer* const frameBuffer) noexcept
+{
+    dptr->output.frameBuffer = frameBuffer;
+    // reconnect to pick up the palette table
+    dptr->fc->connect(static_cast<FrameBuffer*>(&dptr->output));
+    if (dptr->second) dptr->second->connect(static_cast<FrameBuffer*>(&dptr->output));
+}
+void fcpp::core::RunAhead::connect(SampleBuffer* const sampleBuffer) noexcept
+{
+    dptr->output.sampleBuffer = sampleBuffer;
+    dptr->fc->connect(static_cast<SampleBuffer*>(&dptr->output));
+    if (dptr->second) dptr->second->connect(static_cast<SampleBuffer*>(&dptr->output));
+}
+
+void fcpp::core::RunAhead::setFrames(const int frames) noexcept
+{
+    dptr->frames = frames < 0 ? 0 : (8 < frames ? 8 : frames);
+}
+int fcpp::core::RunAhead::getFrames() const noexcept
+{
+    return dptr->frames;
+}
+void fcpp::core::RunAhead::setSecondInstance(const bool enable)
+{
+    if (enable) dptr->second = std::make_unique<FC>(dptr->fc->clone());
+    else dptr->second.reset();
+}
+
+void fcpp::core::RunAhead::exec() noexcept
+{
+    if (dptr->frames == 0) return dptr->run(*dptr->fc, true, true);
+
+    dptr->run(*dptr->fc, false, true);
+    dptr->fc->save(dptr->snapshot);
+
+    auto& target = dptr->second ? *dptr->second : *dptr->fc;
+    if (dptr->second) dptr->second->load(dptr->snapshot);
+    for (int i = 1; i < dptr->frames; i++) dptr->run(target, false, false);
+    dptr->run(target, true, false);
+
+    if (!dptr->second) dptr->fc->load(dptr->snapshot);
+}
@@ -13,36 +13,6 @@ struct fcpp::core::Snapshot::SnapshotData
 
 fcpp::core::Snapshot::Accessor::Accessor(std::uint8_t* const buffer, std::size_t& pos) noexcept : buffer(buffer), pos(pos) {}
 
-void fcpp::core::Snapshot::Writer::access(const bool data) noexcept
-{
-    access(static_cast<std::uint8_t>(data));
-}
-void fcpp::core::Snapshot::Writer::access(const std::uint8_t data) noexcept
-{
-    buffer[pos++] = data;
-}
-void fcpp::core::Snapshot::Writer::access(const void* const data, const std::size_t length) noexcept
-{
-    std::memcpy(buffer + pos, data, length);
-    pos += length;
-}
-
-void fcpp::core::Snapshot::Reader::access(bool& data) const noexcept
-{
-    std::uint8_t value = 0;
-    access(value);
-    data = value;
-}
-void fcpp::core::Snapshot::Reader::access(std::uint8_t& data) const noexcept
-{
-    data = buffer[pos++];
-}
-void fcpp::core::Snapshot::Reader::access(void* const data, const std::size_t length) const noexcept
-{
-    std::memcpy(data, buffer + pos, length);
-    pos += length;
-}
-
 fcpp::core::Snapshot::Snapshot() : dptr(std::make_unique<SnapshotData>()) {}
 fcpp::core::Snapshot::Snapshot(const Snapshot& other) noexcept : dptr(std::make_unique<SnapshotData>())
 {
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <functional>
+#include <string>
 
 #include <QObject>
 
@@ -20,15 +21,22 @@ public:
     {
         bool fullScreen = false;
         bool vsync = true;
+        bool runAheadSecondInstance = false;
         int sampleRate = 44100;
         int engineIdx = 0;
         int renderDriverIdx = 0;
         int spriteLimit = 16;
+        int runAheadFrames = 0;
+        int videoFilterScale = 4;
+        int videoFilterThreads = 1;
         unsigned int tapeLength = 128;
         float scale = 2.0f;
         float volume = 100.0f;
         double fpsLimit = 60.0;
+        // Chrome trace JSON of the session is written here on stop, empty to disable
+        std::string tracePath{};
         fcpp::io::PaletteTable paletteTable{};
+        fcpp::io::VideoFilter::Type videoFilter = fcpp::io::VideoFilter::Type::None;
         fcpp::core::JoypadType joypadType[2] = { fcpp::core::JoypadType::Standard, fcpp::core::JoypadType::Standard };
         int joystickPort[2] = { 0, 0 };
         int turboButtonSpeed[2] = { 6, 6 };
@@ -23,6 +23,7 @@ private:
     void init();
     void connect();
     void configureInput(int idx);
+    void applyVideoFilter();
 private slots:
     void on_push_button_rom_folders_add_clicked();
     void on_push_button_rom_folders_remove_clicked();
@@ -9,6 +9,8 @@
 namespace util
 {
     const QStringList& joypadTypeList();
+    // in the order of fcpp::io::VideoFilter::Type
+    const QStringList& videoFilterList();
 
     fcpp::io::Keyboard keyMap(int key);
     int keyMap(fcpp::io::Keyboard key);
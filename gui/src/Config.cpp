@@ -41,9 +41,15 @@ void Config::save() noexcept
     settings.setValue("RenderDriverIndex", emu.renderDriverIdx);
     settings.setValue("SpriteLimit", emu.spriteLimit);
     settings.setValue("TapeLength", emu.tapeLength);
+    settings.setValue("RunAheadFrames", emu.runAheadFrames);
+    settings.setValue("RunAheadSecondInstance", emu.runAheadSecondInstance);
     settings.setValue("Scale", emu.scale);
+    settings.setValue("VideoFilter", static_cast<int>(emu.videoFilter));
+    settings.setValue("VideoFilterScale", emu.videoFilterScale);
+    settings.setValue("VideoFilterThreads", emu.videoFilterThreads);
     settings.setValue("Volume", emu.volume);
     settings.setValue("FPSLimit", emu.fpsLimit);
+    settings.setValue("TracePath", QString::fromStdString(emu.tracePath));
     settings.setValue("TurboButtonSpeedPort1", emu.turboButtonSpeed[0]);
     settings.setValue("TurboButtonSpeedPort2", emu.turboButtonSpeed[1]);
     settings.setValue("JoypadTypePort1", static_cast<int>(emu.joypadType[0]));
@@ -103,9 +109,15 @@ void Config::load() noexcept
     emu.renderDriverIdx = settings.value("RenderDriverIndex", emu.renderDriverIdx).toInt();
     emu.spriteLimit = settings.value("SpriteLimit", emu.spriteLimit).toInt();
     emu.tapeLength = settings.value("TapeLength", emu.tapeLength).toUInt();
+    emu.runAheadFrames = settings.value("RunAheadFrames", emu.runAheadFrames).toInt();
+    emu.runAheadSecondInstance = settings.value("RunAheadSecondInstance", emu.runAheadSecondInstance).toBool();
     emu.scale = settings.value("Scale", emu.scale).toFloat();
+    emu.videoFilter = static_cast<fcpp::io::VideoFilter::Type>(settings.value("VideoFilter", static_cast<int>(emu.videoFilter)).toInt());
+    emu.videoFilterScale = settings.value("VideoFilterScale", emu.videoFilterScale).toInt();
+    emu.videoFilterThreads = settings.value("VideoFilterThreads", emu.videoFilterThreads).toInt();
     emu.volume = settings.value("Volume", emu.volume).toFloat();
     emu.fpsLimit = settings.value("FPSLimit", emu.fpsLimit).toDouble();
+    emu.tracePath = settings.value("TracePath", QString::fromStdString(emu.tracePath)).toString().toStdString();
     emu.turboButtonSpeed[0] = settings.value("TurboButtonSpeedPort1", emu.turboButtonSpeed[0]).toInt();
     emu.turboButtonSpeed[1] = settings.value("TurboButtonSpeedPort2", emu.turboButtonSpeed[1]).toInt();
     emu.joypadType[0] =	static_cast<fcpp::core::JoypadType>(settings.value("JoypadTypePort1", static_cast<int>(emu.joypadType[0])).toInt());
@@ -1,66 +1,63 @@
+#include <atomic>
+#include <memory>
 #include <string>
-#include <vector>
 #include <thread>
-#include <mutex>
 #include <utility>
 
+#include "FCPP/Util/MPSCQueue.hpp"
 #include "FCPP/Util/Tape.hpp"
+#include "FCPP/Util/Trace.hpp"
 
 #include "Emulator.hpp"
 
 namespace detail
 {
-    struct Messages
+    struct Command
     {
-        struct Message
-        {
-            std::uint16_t msg = 0;
-            explicit operator bool() noexcept
-            {
-                return msg ? msg-- : false;
-            }
-            void send() noexcept
-            {
-                msg++;
-            }
-        } reset{}, save{}, load{};
+        using Arg = fcpp::io::Controller*;
+        using Task = std::function<void(Arg)>;
 
-        void clear() noexcept
+        enum class Type
         {
-            *this = {};
-        }
+            Stop, Pause, Rewind, Reset, QuickSave, QuickLoad, Task
+        } type = Type::Task;
+        Task task{};
     };
 
-    class TaskManager
+    // commands from any thread, handled by the emulation thread between frames
+    class ControlChannel
     {
     public:
-        using Arg = fcpp::io::Controller*;
-        using Task = std::function<void(Arg)>;
-    public:
-        TaskManager() = default;
-        ~TaskManager() = default;
+        ControlChannel() = default;
+        ~ControlChannel() = default;
 
-        void clear() noexcept;
-        void push(Task task);
-        void polls(Arg arg) noexcept;
+        void clear();
+        void push(Command::Type type);
+        void push(Command::Task task);
+        bool pending() const noexcept;
+        bool pop(Command& command);
     private:
-        std::mutex mutex{};
-        std::vector<Task> tasks{};
+        fcpp::util::MPSCQueue<Command> commands{};
     };
-    inline void detail::TaskManager::clear() noexcept
+    inline void ControlChannel::clear()
+    {
+        commands.clear();
+    }
+    inline void ControlChannel::push(const Command::Type type)
+    {
+        commands.push({ type, {} });
+    }
+    inline void ControlChannel::push(Command::Task task)
     {
-        tasks.clear();
+        commands.push({ Command::Type::Task, std::move(task) });
     }
-    inline void TaskManager::push(Task task)
+    inline bool ControlChannel::pending() const noexcept
     {
-        const std::lock_guard<std::mutex> lock(mutex);
-        tasks.emplace_back(std::move(task));
+        return !commands.empty();
     }
-    inline void TaskManager::polls(const Arg arg) noexcept
+    inline bool ControlChannel::pop(Command& command)
     {
-        const std::lock_guard<std::mutex> lock(mutex);
-        for (auto&& task : tasks) task(arg);
-        clear();
+        return commands.pop(command);
     }
 
     class QuickSnapshotSlot
@@ -94,21 +91,15 @@ namespace detail
         void stop() noexcept;
 
         bool isStop() const noexcept;
-        bool isPause() const noexcept;
-        bool isRewind() const noexcept;
-
-        void pushPause(bool v);
-        void pushPause();
-        void pushRewind();
-        void pushMessage(Messages::Message& msg);
     private:
-        bool stopFlag = true, pauseFlag = true, rewindFlag = false;
+        void exec(const std::string& filePath, Emulator::Config config, fcpp::core::INES content);
+    private:
+        std::atomic<bool> stopFlag = true;
         std::thread thread{};
     public:
-        std::uint64_t frameCount = 0;
-        Messages messages{};
+        std::atomic<std::uint64_t> frameCount = 0;
         QuickSnapshotSlot quickSnapshotSlot{};
-        TaskManager taskManager{};
+        ControlChannel controlChannel{};
         Emulator::Config config{};
     };
     EmulatorImpl::~EmulatorImpl()
@@ -121,140 +112,181 @@ namespace detail
         if (!rom.load(filePath.c_str()) || !fcpp::core::Cartridge::support(rom)) return false;
         stop();
         frameCount = 0;
-        stopFlag = pauseFlag = rewindFlag = false;
-        messages.clear();
+        stopFlag = false;
         quickSnapshotSlot.clear();
-        taskManager.clear();
+        controlChannel.clear();
         thread = std::thread([=](Emulator::Config config, fcpp::core::INES content)
             {
-                fcpp::core::FC fc{};
-                if (!fc.insertCartridge(std::move(content))) return;
+                exec(filePath, std::move(config), std::move(content));
+                stopFlag = true;
+            }, config, std::move(rom));
+        return true;
+    }
+    void EmulatorImpl::exec(const std::string& filePath, Emulator::Config config, fcpp::core::INES content)
+    {
+        fcpp::util::Trace::setThreadName("emulation");
+        fcpp::core::FC fc{};
+        if (!fc.insertCartridge(std::move(content))) return;
 
-                bool recordFlag = false;
-                fcpp::util::Tape<fcpp::core::Snapshot> tape{ config.tapeLength };
-                auto controller = fcpp::io::manager::create(config.engineIdx);
+        // only touched by this thread, other threads go through the control channel
+        bool runFlag = true, pauseFlag = false, rewindFlag = false, frameFlag = false, recordFlag = false;
+        fcpp::util::Tape<fcpp::core::Snapshot> tape{ config.tapeLength };
+        auto controller = fcpp::io::manager::create(config.engineIdx);
 
-                if (!controller) return;
-                controller->setTitle(filePath.c_str());
-                controller->setScale(config.scale);
-                controller->setFPSLimit(config.fpsLimit);
-                controller->setSampleRate(config.sampleRate);
-                controller->setVolume(config.volume);
-                controller->setBorderless(config.fullScreen);
-                controller->setVerticalSync(config.vsync);
-                controller->setPaletteTable(config.paletteTable);
-                controller->setRenderDriver(config.renderDriverIdx);
-                controller->setJoypadType(0, config.joypadType[0]);
-                controller->setJoypadType(1, config.joypadType[1]);
-                controller->setTurboButtonSpeed(0, config.turboButtonSpeed[0]);
-                controller->setTurboButtonSpeed(1, config.turboButtonSpeed[1]);
-                controller->setJoystickPort(0, config.joystickPort[0]);
-                controller->setJoystickPort(1, config.joystickPort[1]);
-                controller->bind(0, config.keyboardMap[0]);
-                controller->bind(1, config.keyboardMap[1]);
-                controller->bind(0, config.joystickMap[0]);
-                controller->bind(1, config.joystickMap[1]);
-                controller->setJoystickPort(1, config.joystickPort[1]);
-                controller->setCloseCallback([&]() {stopFlag = true; });
-                controller->setRenderCallback([&]()
-                    {
-                        if (!(frameCount++ & 0x0f) && !isPause() && !isRewind())
-                        {
-                            messages.save.send();
-                            recordFlag = true;
-                        }
-                        taskManager.polls(controller.get());
-                    });
-                controller->setKeyPressCallback([&](const fcpp::io::Keyboard key)
-                    {
-                        switch (key)
-                        {
-                        case fcpp::io::Keyboard::Escape:
-                            stopFlag = true;
-                            break;
-                        case fcpp::io::Keyboard::F1:
-                            messages.save.send();
-                            break;
-                        case fcpp::io::Keyboard::F2:
-                            messages.load.send();
-                            break;
-                        case fcpp::io::Keyboard::F3:
-                            messages.reset.send();
-                            break;
-                        case fcpp::io::Keyboard::F4:
-                            pushPause();
-                            break;
-                        case fcpp::io::Keyboard::F5:
-                            pushRewind();
-                            break;
-                        default:
-                            break;
-                        }
-                    });
-                if (!controller->create()) return;
+        if (!controller) return;
+        controller->setTitle(filePath.c_str());
+        controller->setScale(config.scale);
+        controller->setVideoFilter(config.videoFilter, config.videoFilterScale, config.videoFilterThreads);
+        controller->setFPSLimit(config.fpsLimit);
+        controller->setSampleRate(config.sampleRate);
+        controller->setVolume(config.volume);
+        controller->setBorderless(config.fullScreen);
+        controller->setVerticalSync(config.vsync);
+        controller->setPaletteTable(config.paletteTable);
+        controller->setRenderDriver(config.renderDriverIdx);
+        controller->setJoypadType(0, config.joypadType[0]);
+        controller->setJoypadType(1, config.joypadType[1]);
+        controller->setTurboButtonSpeed(0, config.turboButtonSpeed[0]);
+        controller->setTurboButtonSpeed(1, config.turboButtonSpeed[1]);
+        controller->setJoystickPort(0, config.joystickPort[0]);
+        controller->setJoystickPort(1, config.joystickPort[1]);
+        controller->bind(0, config.keyboardMap[0]);
+        controller->bind(1, config.keyboardMap[1]);
+        controller->bind(0, config.joystickMap[0]);
+        controller->bind(1, config.joystickMap[1]);
+        controller->setJoystickPort(1, config.joystickPort[1]);
+        controller->setCloseCallback([&]() { controlChannel.push(Command::Type::Stop); });
+        controller->setRenderCallback([&]()
+            {
+                frameFlag = true;
+                if (!(frameCount.fetch_add(1, std::memory_order_relaxed) & 0x0f) && !pauseFlag && !rewindFlag) recordFlag = true;
+            });
+        controller->setKeyPressCallback([&](const fcpp::io::Keyboard key)
+            {
+                switch (key)
+                {
+                case fcpp::io::Keyboard::Escape:
+                    controlChannel.push(Command::Type::Stop);
+                    break;
+                case fcpp::io::Keyboard::F1:
+                    controlChannel.push(Command::Type::QuickSave);
+                    break;
+                case fcpp::io::Keyboard::F2:
+                    controlChannel.push(Command::Type::QuickLoad);
+                    break;
+                case fcpp::io::Keyboard::F3:
+                    controlChannel.push(Command::Type::Reset);
+                    break;
+                case fcpp::io::Keyboard::F4:
+                    controlChannel.push(Command::Type::Pause);
+                    break;
+                case fcpp::io::Keyboard::F5:
+                    controlChannel.push(Command::Type::Rewind);
+                    break;
+                default:
+                    break;
+                }
+            });
+        if (!controller->create()) return;
 
-                fc.setFrameRate(config.fpsLimit);
-                fc.setSpriteLimit(config.spriteLimit);
-                fc.connect(0, controller->getInputScanner(0));
-                fc.connect(1, controller->getInputScanner(1));
-                fc.connect(controller->getFrameBuffer());
-                fc.connect(controller->getSampleBuffer());
-                fc.powerOn();
+        fc.setFrameRate(config.fpsLimit);
+        fc.setSpriteLimit(config.spriteLimit);
+        std::unique_ptr<fcpp::core::RunAhead> runAhead{};
 
-                emit gEmulator.started();
+        fc.connect(0, controller->getInputScanner(0));
+        fc.connect(1, controller->getInputScanner(1));
+        if (config.runAheadFrames > 0)
+        {
+            runAhead = std::make_unique<fcpp::core::RunAhead>(&fc);
+            runAhead->connect(controller->getFrameBuffer());
+            runAhead->connect(controller->getSampleBuffer());
+            runAhead->setFrames(config.runAheadFrames);
+        }
+        else
+        {
+            fc.connect(controller->getFrameBuffer());
+            fc.connect(controller->getSampleBuffer());
+        }
+        fc.powerOn();
+        if (runAhead) runAhead->setSecondInstance(config.runAheadSecondInstance);
 
-                while (!stopFlag)
+        auto runFrame = [&]()
+        {
+            fcpp::util::Trace::Scope scope{ "frame" };
+            if (runAhead) runAhead->exec();
+            else for (frameFlag = false; !frameFlag;) fc.exec();
+        };
+
+        if (!config.tracePath.empty()) fcpp::util::Trace::enable(true);
+        emit gEmulator.started();
+
+        while (runFlag)
+        {
+            for (Command command{}; controlChannel.pending() && controlChannel.pop(command);)
+            {
+                switch (command.type)
                 {
-                    if (messages.reset) fc.reset(), pushPause(false);
-                    else if (messages.save) fc.save(recordFlag ? recordFlag = false, tape.next() : quickSnapshotSlot.get());
-                    else if (messages.load) fc.load(rewindFlag ? pushPause(true), tape.load() : quickSnapshotSlot.get());
-                    else if (pauseFlag) controller->render();
-                    else fc.exec();
+                case Command::Type::Stop:
+                    runFlag = false;
+                    break;
+                case Command::Type::Pause:
+                    if (!(pauseFlag = !pauseFlag)) rewindFlag = false;
+                    break;
+                case Command::Type::Rewind:
+                    // show the restored frame before pausing on it
+                    fc.load(tape.load());
+                    rewindFlag = true;
+                    runFrame();
+                    pauseFlag = true;
+                    break;
+                case Command::Type::Reset:
+                    fc.reset();
+                    pauseFlag = rewindFlag = false;
+                    break;
+                case Command::Type::QuickSave:
+                    fc.save(quickSnapshotSlot.get());
+                    break;
+                case Command::Type::QuickLoad:
+                    fc.load(quickSnapshotSlot.get());
+                    break;
+                case Command::Type::Task:
+                    command.task(controller.get());
+                    break;
                 }
+            }
+            if (!runFlag) break;
 
-                fc.save(quickSnapshotSlot.get());
-                emit gEmulator.stopped();
-            }, config, std::move(rom));
-        return true;
+            if (pauseFlag) controller->render();
+            else runFrame();
+
+            if (recordFlag)
+            {
+                recordFlag = false;
+                fc.save(tape.next());
+            }
+        }
+
+        fc.save(quickSnapshotSlot.get());
+        if (!config.tracePath.empty())
+        {
+            fcpp::util::Trace::enable(false);
+            fcpp::util::Trace::dump(config.tracePath.c_str());
+        }
+        emit gEmulator.stopped();
     }
     inline void EmulatorImpl::stop() noexcept
     {
+        if (thread.joinable())
+        {
+            controlChannel.push(Command::Type::Stop);
+            thread.join();
+        }
         stopFlag = true;
-        if (thread.joinable()) thread.join();
     }
     inline bool EmulatorImpl::isStop() const noexcept
     {
         return stopFlag;
     }
-    inline bool EmulatorImpl::isPause() const noexcept
-    {
-        return pauseFlag;
-    }
-    inline bool EmulatorImpl::isRewind() const noexcept
-    {
-        return rewindFlag;
-    }
-    inline void EmulatorImpl::pushPause(const bool v)
-    {
-        taskManager.push([=](auto) {if (!(pauseFlag = v)) rewindFlag = false; });
-    }
-    inline void detail::EmulatorImpl::pushPause()
-    {
-        pushPause(!isPause());
-    }
-    inline void EmulatorImpl::pushRewind()
-    {
-        taskManager.push([=](auto)
-            {
-                rewindFlag = true;
-                pauseFlag = false;
-                messages.load.send();
-            });
-    }
-    inline void EmulatorImpl::pushMessage(Messages::Message& msg)
-    {
-        taskManager.push([&](auto) {msg.send(); });
-    }
 }
 
 struct Emulator::EmulatorData
@@ -304,26 +336,26 @@ void Emulator::stop() noexcept
 }
 void Emulator::pause()
 {
-    dptr->impl.pushPause();
+    dptr->impl.controlChannel.push(detail::Command::Type::Pause);
 }
 
 void Emulator::pushTask(const std::function<void(fcpp::io::Controller*)>& task)
 {
-    dptr->impl.taskManager.push(task);
+    dptr->impl.controlChannel.push(task);
 }
 void Emulator::pushRewind()
 {
-    dptr->impl.pushRewind();
+    dptr->impl.controlChannel.push(detail::Command::Type::Rewind);
 }
 void Emulator::pushReset()
 {
-    dptr->impl.pushMessage(dptr->impl.messages.reset);
+    dptr->impl.controlChannel.push(detail::Command::Type::Reset);
 }
 void Emulator::pushQuickSave()
 {
-    dptr->impl.pushMessage(dptr->impl.messages.save);
+    dptr->impl.controlChannel.push(detail::Command::Type::QuickSave);
 }
 void Emulator::pushQuickLoad()
 {
-    dptr->impl.pushMessage(dptr->impl.messages.load);
+    dptr->impl.controlChannel.push(detail::Command::Type::QuickLoad);
 }
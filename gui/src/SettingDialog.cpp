@@ -25,10 +25,16 @@ void SettingDialog::init()
     ui->check_box_emu_full_screen->setChecked(gConfig.emu.fullScreen);
     ui->check_box_emu_vsync->setChecked(gConfig.emu.vsync);
     ui->double_spin_box_emu_scale->setValue(gConfig.emu.scale);
+    ui->combo_box_emu_video_filter->addItems(util::videoFilterList());
+    ui->combo_box_emu_video_filter->setCurrentIndex(static_cast<int>(gConfig.emu.videoFilter));
+    ui->spin_box_emu_video_filter_scale->setValue(gConfig.emu.videoFilterScale);
+    ui->spin_box_emu_video_filter_threads->setValue(gConfig.emu.videoFilterThreads);
     ui->double_spin_box_emu_fps->setValue(gConfig.emu.fpsLimit);
     ui->spin_box_emu_sample_rate->setValue(gConfig.emu.sampleRate);
     ui->spin_box_emu_tape_length->setValue(gConfig.emu.tapeLength);
     ui->spin_box_emu_sprite_limit->setValue(gConfig.emu.spriteLimit);
+    ui->spin_box_emu_run_ahead->setValue(gConfig.emu.runAheadFrames);
+    ui->check_box_emu_run_ahead_second_instance->setChecked(gConfig.emu.runAheadSecondInstance);
     ui->horizontal_slider_emu_volume->setValue(gConfig.emu.volume);
     romFoldersModel.setStringList(gConfig.gui.romFolders);
     ui->list_view_rom_folders->setModel(&romFoldersModel);
@@ -100,6 +106,24 @@ void SettingDialog::connect()
         [](const int state) {gConfig.emu.vsync = state == Qt::CheckState::Checked; });
     QObject::connect(ui->double_spin_box_emu_scale, qOverload<double>(&QDoubleSpinBox::valueChanged), this,
         [](const double value) {gConfig.emu.scale = static_cast<float>(value); });
+    QObject::connect(ui->combo_box_emu_video_filter, qOverload<int>(&QComboBox::activated), this,
+        [this](const int idx)
+        {
+            gConfig.emu.videoFilter = static_cast<fcpp::io::VideoFilter::Type>(idx);
+            applyVideoFilter();
+        });
+    QObject::connect(ui->spin_box_emu_video_filter_scale, qOverload<int>(&QSpinBox::valueChanged), this,
+        [this](const int value)
+        {
+            gConfig.emu.videoFilterScale = value;
+            applyVideoFilter();
+        });
+    QObject::connect(ui->spin_box_emu_video_filter_threads, qOverload<int>(&QSpinBox::valueChanged), this,
+        [this](const int value)
+        {
+            gConfig.emu.videoFilterThreads = value;
+            applyVideoFilter();
+        });
     QObject::connect(ui->double_spin_box_emu_fps, qOverload<double>(&QDoubleSpinBox::valueChanged), this,
         [](const double value) {gConfig.emu.fpsLimit = value; });
     QObject::connect(ui->spin_box_emu_sample_rate, qOverload<int>(&QSpinBox::valueChanged), this,
@@ -108,6 +132,10 @@ void SettingDialog::connect()
         [](const int value) {gConfig.emu.tapeLength = value; });
     QObject::connect(ui->spin_box_emu_sprite_limit, qOverload<int>(&QSpinBox::valueChanged), this,
         [](const int value) {gConfig.emu.spriteLimit = value; });
+    QObject::connect(ui->spin_box_emu_run_ahead, qOverload<int>(&QSpinBox::valueChanged), this,
+        [](const int value) {gConfig.emu.runAheadFrames = value; });
+    QObject::connect(ui->check_box_emu_run_ahead_second_instance, &QCheckBox::stateChanged, this,
+        [](const int state) {gConfig.emu.runAheadSecondInstance = state == Qt::CheckState::Checked; });
     QObject::connect(ui->horizontal_slider_emu_volume, &QSlider::valueChanged, this,
         [](const int value)
         {
@@ -123,6 +151,12 @@ void SettingDialog::connect()
             [=](const QColor& color) {gConfig.emu.paletteTable.set(i, color.rgb()); });
     }
 }
+void SettingDialog::applyVideoFilter()
+{
+    gEmulator.pushTask([](fcpp::io::Controller* controller) {
+        controller->setVideoFilter(gConfig.emu.videoFilter, gConfig.emu.videoFilterScale, gConfig.emu.videoFilterThreads);
+    });
+}
 void SettingDialog::configureInput(const int idx)
 {
     InputConfigureDialog inputConfigureDialog{};
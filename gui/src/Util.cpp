@@ -21,6 +21,11 @@ const QStringList& util::joypadTypeList()
     static const QStringList list{ "Standard" };
     return list;
 }
+const QStringList& util::videoFilterList()
+{
+    static const QStringList list{ "None", "Nearest", "Scale2x", "NTSC" };
+    return list;
+}
 
 fcpp::io::Keyboard util::keyMap(const int key)
 {
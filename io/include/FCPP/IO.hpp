@@ -3,11 +3,14 @@
 
 #include "FCPP/IO/InputDevice.hpp"
 #include "FCPP/IO/PaletteTable.hpp"
+#include "FCPP/IO/Recorder.hpp"
+#include "FCPP/IO/VideoFilter.hpp"
 
 #include "FCPP/IO/Controller.hpp"
 #include "FCPP/IO/SDL2/SDL2Controller.hpp"
 #include "FCPP/IO/SFML2/SFML2Controller.hpp"
 #include "FCPP/IO/RayLib/RayLibController.hpp"
+#include "FCPP/IO/Null/NullController.hpp"
 
 #include "FCPP/IO/Manager.hpp"
 
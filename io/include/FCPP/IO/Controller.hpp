@@ -10,6 +10,7 @@
 
 #include "FCPP/IO/InputDevice.hpp"
 #include "FCPP/IO/PaletteTable.hpp"
+#include "FCPP/IO/VideoFilter.hpp"
 
 namespace fcpp::io
 {
@@ -19,6 +20,15 @@ namespace fcpp::io
 class fcpp::io::Controller
 {
 public:
+    // frame pacing since the last query, times in milliseconds
+    struct PacingStats
+    {
+        std::uint64_t frames = 0;
+        std::uint64_t missed = 0;
+        double meanFrameTime = 0.0;
+        double jitter = 0.0;
+        double maxLateness = 0.0;
+    };
     class Info
     {
     public:
@@ -44,14 +54,27 @@ public:
     virtual fcpp::core::InputScanner* getInputScanner(int idx) noexcept = 0;
     virtual fcpp::core::SampleBuffer* getSampleBuffer() noexcept = 0;
     virtual void render() noexcept = 0;
+    /*
+    * present frames on a separate thread so the emulation never blocks on vsync, must be set before create(),
+    * the thread owns the window and handles its events, which macOS only allows on the main thread, so it is ignored there
+    */
+    virtual void setPresentThread(bool enable) noexcept = 0;
     virtual bool setFullScreen(bool enable) noexcept = 0;
     virtual bool setBorderless(bool enable) noexcept = 0;
     virtual bool setVerticalSync(bool enable) noexcept = 0;
     virtual bool setRenderDriver(int idx) noexcept = 0;
     virtual bool setJoystickPort(int idx, int port) noexcept = 0;
     virtual void setScale(float factor) noexcept = 0;
+    // CPU-side post-processing of frames before they are presented, the window keeps its size, see VideoFilter,
+    // throws like VideoFilter::set if the buffers or worker threads of the filter cannot be allocated
+    virtual void setVideoFilter(VideoFilter::Type type, int scale, int threads) = 0;
     virtual void setTitle(const char* text) noexcept = 0;
     virtual void setFPSLimit(double fps) noexcept = 0;
+    // pace frames from the audio buffer fill level instead of the wall clock alone
+    virtual void setAudioSync(bool enable) noexcept = 0;
+    virtual PacingStats getPacingStats() noexcept = 0;
+    // bars over the top left of the frame with values in [0, 1], count 0 to hide
+    virtual void setOverlay(const float* values, int count) noexcept = 0;
     virtual void setVolume(float volume) noexcept = 0;
     virtual void setSampleRate(int rate) noexcept = 0;
     virtual void setJoypadType(int idx, fcpp::core::JoypadType type) noexcept = 0;
@@ -0,0 +1,94 @@
+#ifndef FCPP_IO_NULL_CONTROLLER_HPP
+#define FCPP_IO_NULL_CONTROLLER_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include <FCPPIOExport.hpp>
+
+#include "FCPP/IO/Controller.hpp"
+
+namespace fcpp::io
+{
+    class NullController;
+}
+
+/*
+* Headless controller without window or audio device, runs as fast as possible unless a FPS limit is set.
+* Frames are kept in memory and can be dumped together with the audio as raw data,
+* input comes from an optional script.
+*/
+class fcpp::io::NullController : public fcpp::io::Controller
+{
+private:
+    struct NullControllerData;
+public:
+    class Info : public Controller::Info
+    {
+    public:
+        Info() = default;
+        ~Info() override = default;
+        int getRenderDriverCount() noexcept override;
+        const char* getRenderDriverName(int idx) noexcept override;
+    };
+    class JoystickHelper : public Controller::JoystickHelper
+    {
+    public:
+        JoystickHelper() = default;
+        ~JoystickHelper() override = default;
+        bool joystickPressed(int port, fcpp::io::Joystick& buttons) noexcept override;
+        int joystickCount() noexcept override;
+    };
+public:
+    NullController();
+    ~NullController() noexcept override;
+
+    // 32-bit ARGB frames in native byte order at the size of the video filter output, nullptr to stop
+    FCPP_IO_EXPORT bool setVideoDump(const char* path) noexcept;
+    // 16-bit signed mono samples in native byte order at the sample rate, nullptr to stop
+    FCPP_IO_EXPORT bool setAudioDump(const char* path) noexcept;
+    /*
+    * Text file with one line per input change: frame joypad1 joypad2
+    * the buttons are a hex mask, A is bit 0 then B, Select, Start, Up, Down, Left, Right,
+    * the input is held until the next line and lines starting with '#' are ignored
+    */
+    FCPP_IO_EXPORT bool setInputScript(const char* path) noexcept;
+    FCPP_IO_EXPORT std::uint32_t getFrameCount() const noexcept;
+
+    bool create() noexcept override;
+    fcpp::core::FrameBuffer* getFrameBuffer() noexcept override;
+    fcpp::core::InputScanner* getInputScanner(int idx) noexcept override;
+    fcpp::core::SampleBuffer* getSampleBuffer() noexcept override;
+    void render() noexcept override;
+    void setPresentThread(bool enable) noexcept override;
+    bool setFullScreen(bool enable) noexcept override;
+    bool setBorderless(bool enable) noexcept override;
+    bool setVerticalSync(bool enable) noexcept override;
+    bool setRenderDriver(int idx) noexcept override;
+    bool setJoystickPort(int idx, int port) noexcept override;
+    void setScale(float factor) noexcept override;
+    void setVideoFilter(VideoFilter::Type type, int scale, int threads) override;
+    void setTitle(const char* text) noexcept override;
+    void setFPSLimit(double fps) noexcept override;
+    void setAudioSync(bool enable) noexcept override;
+    PacingStats getPacingStats() noexcept override;
+    void setOverlay(const float* values, int count) noexcept override;
+    void setVolume(float volume) noexcept override;
+    void setSampleRate(int rate) noexcept override;
+    void setJoypadType(int idx, fcpp::core::JoypadType type) noexcept override;
+    void setPaletteTable(const PaletteTable& paletteTable) noexcept override;
+    void setPaletteTable(PaletteTable&& paletteTable) noexcept override;
+    void setTurboButtonSpeed(int idx, std::uint8_t v) noexcept override;
+    void setFrameBufferData(const std::uint8_t* data) noexcept override;
+    void getFrameBufferData(std::uint8_t* data) const noexcept override;
+    void bind(int idx, int standardButtonIdx, Keyboard key) noexcept override;
+    void bind(int idx, int standardButtonIdx, Joystick button) noexcept override;
+    void setKeyPressCallback(std::function<void(Keyboard)> callback) noexcept override;
+    void setFrameCompleteCallback(std::function<void()> callback) noexcept override;
+    void setRenderCallback(std::function<void()> callback) noexcept override;
+    void setCloseCallback(std::function<void()> callback) noexcept override;
+private:
+    const std::unique_ptr<NullControllerData> dptr;
+};
+
+#endif
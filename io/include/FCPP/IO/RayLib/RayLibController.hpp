@@ -41,14 +41,19 @@ public:
     fcpp::core::InputScanner* getInputScanner(int idx) noexcept override;
     fcpp::core::SampleBuffer* getSampleBuffer() noexcept override;
     void render() noexcept override;
+    void setPresentThread(bool enable) noexcept override;
     bool setFullScreen(bool enable) noexcept override;
     bool setBorderless(bool enable) noexcept override;
     bool setVerticalSync(bool enable) noexcept override;
     bool setRenderDriver(int idx) noexcept override;
     bool setJoystickPort(int idx, int port) noexcept override;
     void setScale(float factor) noexcept override;
+    void setVideoFilter(VideoFilter::Type type, int scale, int threads) override;
     void setTitle(const char* text) noexcept override;
     void setFPSLimit(double fps) noexcept override;
+    void setAudioSync(bool enable) noexcept override;
+    PacingStats getPacingStats() noexcept override;
+    void setOverlay(const float* values, int count) noexcept override;
     void setVolume(float volume) noexcept override;
     void setSampleRate(int rate) noexcept override;
     void setJoypadType(int idx, fcpp::core::JoypadType type) noexcept override;
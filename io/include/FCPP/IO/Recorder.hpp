@@ -0,0 +1,59 @@
+#ifndef FCPP_IO_RECORDER_HPP
+#define FCPP_IO_RECORDER_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include <FCPPIOExport.hpp>
+
+#include "FCPP/Core/Interface/FrameBuffer.hpp"
+#include "FCPP/Core/Interface/SampleBuffer.hpp"
+
+namespace fcpp::io
+{
+    class Recorder;
+}
+
+/*
+* Records the frames and samples of a machine to a Y4M or raw RGB video file and a WAV audio file.
+* The taps sit between the machine and its outputs, each frame is copied with the samples since the last one
+* to a lock-free ring, and a writer thread encodes and writes them, so file IO never runs on the emulation thread.
+* If the writer falls behind, frames are dropped and the audio is kept, unless blocking is set,
+* then the machine waits for the writer, which is meant for rendering to files as fast as possible.
+*/
+class fcpp::io::Recorder
+{
+private:
+    struct RecorderData;
+public:
+    enum class VideoFormat
+    {
+        // YUV 4:4:4 with the NES frame rate and pixel aspect ratio
+        Y4M,
+        // headerless 24-bit RGB, 256x240
+        RGB
+    };
+public:
+    FCPP_IO_EXPORT Recorder();
+    FCPP_IO_EXPORT ~Recorder() noexcept;
+
+    // connect the returned buffers to the machine instead of output, output may be nullptr
+    FCPP_IO_EXPORT fcpp::core::FrameBuffer* tap(fcpp::core::FrameBuffer* output) noexcept;
+    FCPP_IO_EXPORT fcpp::core::SampleBuffer* tap(fcpp::core::SampleBuffer* output) noexcept;
+    FCPP_IO_EXPORT void setBlocking(bool enable) noexcept;
+
+    /*
+    * either path may be nullptr to skip it, every decimation-th frame is kept,
+    * start and stop are called between frames on the thread running the machine
+    */
+    FCPP_IO_EXPORT bool start(const char* videoPath, VideoFormat format, const char* audioPath, int decimation = 1);
+    // write everything queued and close the files
+    FCPP_IO_EXPORT void stop() noexcept;
+    FCPP_IO_EXPORT bool isRecording() const noexcept;
+    FCPP_IO_EXPORT std::uint32_t getFrameCount() const noexcept;
+    FCPP_IO_EXPORT std::uint32_t getDroppedFrames() const noexcept;
+private:
+    const std::unique_ptr<RecorderData> dptr;
+};
+
+#endif
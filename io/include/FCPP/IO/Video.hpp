@@ -1,15 +1,23 @@
 #ifndef FCPP_IO_VIDEO_HPP
 #define FCPP_IO_VIDEO_HPP
 
+#include <atomic>
 #include <functional>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "FCPP/Core/Interface/FrameBuffer.hpp"
 
+#include "FCPP/IO/Controller.hpp"
 #include "FCPP/IO/InputDevice.hpp"
 #include "FCPP/IO/PaletteTable.hpp"
 
 #include "FCPP/Util/FPSLimiter.hpp"
+#include "FCPP/Util/Semaphore.hpp"
+#include "FCPP/Util/TripleBuffer.hpp"
+#include "FCPP/Util/Trace.hpp"
 
 namespace fcpp::io::detail
 {
@@ -25,16 +33,35 @@ public:
     void setPaletteTable(const PaletteTable& data);
     void setPaletteTable(PaletteTable&& data) noexcept;
     void setFPSLimit(double fps) noexcept;
+    void setAudioClock(std::function<double()> fillLevel) noexcept;
+    // reset after each query
+    Controller::PacingStats getPacingStats() noexcept;
 
     void setKeyPressCallback(std::function<void(Keyboard)> callback) noexcept;
     void setFrameCompleteCallback(std::function<void()> callback) noexcept;
     void setRenderCallback(std::function<void()> callback) noexcept;
     void setCloseCallback(std::function<void()> callback) noexcept;
+    // present frames on a separate thread that owns the window, must be set before create(), ignored on macOS
+    void setPresentThread(bool enable) noexcept;
 protected:
     using FrameBuffer::setPixel;
     using FrameBuffer::completedSignal;
     const std::uint32_t* getPaletteTable() noexcept override;
 protected:
+    // run init on a new thread, then step until stopped and quit, false if init failed
+    bool startPresentThread(std::function<bool()> init, std::function<void()> step, std::function<void()> quit);
+    void stopPresentThread() noexcept;
+    bool presenting() const noexcept;
+    // queue task for the present thread, false if it should run on the calling thread
+    bool post(std::function<void()> task);
+    void runPosted();
+protected:
+    bool presentThreadFlag = false;
+    std::atomic<bool> presentStopFlag{ false };
+    std::thread presentThread{};
+    std::mutex taskMutex{};
+    std::vector<std::function<void()>> tasks{};
+
     fcpp::io::PaletteTable paletteTable{};
     fcpp::util::AdaptiveFPSLimiter fpsLimiter{ 60.0 };
 
@@ -56,6 +83,16 @@ inline void fcpp::io::detail::Video::setFPSLimit(const double fps) noexcept
 {
     fpsLimiter.set(fps > 0.0 ? fps : 500.0);
 }
+inline void fcpp::io::detail::Video::setAudioClock(std::function<double()> fillLevel) noexcept
+{
+    fpsLimiter.setAudioClock(std::move(fillLevel));
+}
+inline fcpp::io::Controller::PacingStats fcpp::io::detail::Video::getPacingStats() noexcept
+{
+    auto stats = fpsLimiter.getStats();
+    fpsLimiter.resetStats();
+    return { stats.frames, stats.missed, stats.meanFrameTime, stats.jitter, stats.maxLateness };
+}
 inline void fcpp::io::detail::Video::setKeyPressCallback(std::function<void(Keyboard)> callback) noexcept
 {
     keyPressCallback = std::move(callback);
@@ -72,9 +109,63 @@ inline void fcpp::io::detail::Video::setCloseCallback(std::function<void()> call
 {
     closeCallback = std::move(callback);
 }
+inline void fcpp::io::detail::Video::setPresentThread(const bool enable) noexcept
+{
+#ifdef __APPLE__
+    // windows and events only work on the main thread on macOS
+    static_cast<void>(enable);
+    presentThreadFlag = false;
+#else
+    presentThreadFlag = enable;
+#endif
+}
 inline const std::uint32_t* fcpp::io::detail::Video::getPaletteTable() noexcept
 {
     return paletteTable.get();
 }
+inline bool fcpp::io::detail::Video::startPresentThread(std::function<bool()> init, std::function<void()> step, std::function<void()> quit)
+{
+    if (presenting()) return true;
+
+    bool ret = false;
+    fcpp::util::Semaphore ready{};
+    presentStopFlag = false;
+    presentThread = std::thread([&, init = std::move(init), step = std::move(step), quit = std::move(quit)]() {
+        fcpp::util::Trace::setThreadName("present");
+        bool created = ret = init();
+        ready.release();
+        if (created) while (!presentStopFlag) runPosted(), step();
+        quit();
+    });
+    ready.acquire();
+    if (!ret) presentThread.join();
+    return ret;
+}
+inline void fcpp::io::detail::Video::stopPresentThread() noexcept
+{
+    presentStopFlag = true;
+    if (presentThread.joinable()) presentThread.join();
+}
+inline bool fcpp::io::detail::Video::presenting() const noexcept
+{
+    return presentThread.joinable();
+}
+inline bool fcpp::io::detail::Video::post(std::function<void()> task)
+{
+    if (!presenting() || presentThread.get_id() == std::this_thread::get_id()) return false;
+    std::lock_guard lock{ taskMutex };
+    tasks.push_back(std::move(task));
+    return true;
+}
+inline void fcpp::io::detail::Video::runPosted()
+{
+    std::vector<std::function<void()>> pending{};
+    {
+        std::lock_guard lock{ taskMutex };
+        if (tasks.empty()) return;
+        pending.swap(tasks);
+    }
+    for (auto&& task : pending) task();
+}
 
 #endif
@@ -0,0 +1,52 @@
+#ifndef FCPP_IO_VIDEO_FILTER_HPP
+#define FCPP_IO_VIDEO_FILTER_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include <FCPPIOExport.hpp>
+
+namespace fcpp::io
+{
+    class VideoFilter;
+}
+
+/*
+* CPU-side post-processing of 256x240 frames before they are presented.
+* Nearest repeats pixels, Scale2x is the edge-directed EPX scaler applied once for 2x and twice for 4x,
+* NTSC encodes each line as a composite signal with the NES color carrier and decodes it again,
+* which gives the color fringes and dot crawl of a TV. Work is split across threads by bands of lines.
+*/
+class fcpp::io::VideoFilter
+{
+private:
+    struct VideoFilterData;
+public:
+    enum class Type
+    {
+        None, Nearest, Scale2x, NTSC
+    };
+    // RGBA are the bytes in memory order
+    enum class PixelFormat
+    {
+        ARGB, RGBA
+    };
+public:
+    FCPP_IO_EXPORT explicit VideoFilter(PixelFormat format = PixelFormat::ARGB);
+    FCPP_IO_EXPORT ~VideoFilter() noexcept;
+
+    /*
+    * scale is rounded down to one the type supports, Nearest takes 1 to 4, Scale2x and NTSC take 2 or 4,
+    * None always outputs the frame as it is, threads include the calling one, 0 for one per hardware thread
+    */
+    FCPP_IO_EXPORT void set(Type type, int scale, int threads = 1);
+    FCPP_IO_EXPORT Type getType() const noexcept;
+    FCPP_IO_EXPORT int getWidth() const noexcept;
+    FCPP_IO_EXPORT int getHeight() const noexcept;
+    // returns getWidth() x getHeight() pixels valid until the next call, the frame itself for None
+    FCPP_IO_EXPORT const std::uint32_t* process(const std::uint32_t* frame) noexcept;
+private:
+    const std::unique_ptr<VideoFilterData> dptr;
+};
+
+#endif
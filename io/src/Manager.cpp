@@ -1,4 +1,5 @@
 #include "FCPP/IO/Manager.hpp"
+#include "FCPP/IO/Null/NullController.hpp"
 
 #ifdef FCPP_IO_SDL2
 #include "FCPP/IO/SDL2/SDL2Controller.hpp"
@@ -22,6 +23,7 @@ int fcpp::io::manager::count() noexcept
 #ifdef FCPP_IO_RAYLIB
     counter++;
 #endif
+    counter++; // Null
     return counter;
 }
 const char* fcpp::io::manager::name(const int idx) noexcept
@@ -36,6 +38,7 @@ const char* fcpp::io::manager::name(const int idx) noexcept
 #ifdef FCPP_IO_RAYLIB
     if (idx == counter++) return "raylib";
 #endif
+    if (idx == counter) return "Null";
     return nullptr;
 }
 std::unique_ptr<fcpp::io::Controller> fcpp::io::manager::create(const int idx)
@@ -50,6 +53,7 @@ std::unique_ptr<fcpp::io::Controller> fcpp::io::manager::create(const int idx)
 #ifdef FCPP_IO_RAYLIB
     if (idx == counter++) return std::make_unique<fcpp::io::RayLibController>();
 #endif
+    if (idx == counter) return std::make_unique<fcpp::io::NullController>();
     return nullptr;
 }
 std::unique_ptr<fcpp::io::Controller::Info> fcpp::io::manager::info(const int idx)
@@ -64,6 +68,7 @@ std::unique_ptr<fcpp::io::Controller::Info> fcpp::io::manager::info(const int id
 #ifdef FCPP_IO_RAYLIB
     if (idx == counter++) return std::make_unique<fcpp::io::RayLibController::Info>();
 #endif
+    if (idx == counter) return std::make_unique<fcpp::io::NullController::Info>();
     return nullptr;
 }
 std::unique_ptr<fcpp::io::Controller::JoystickHelper> fcpp::io::manager::joystickHelper(const int idx)
@@ -78,5 +83,6 @@ std::unique_ptr<fcpp::io::Controller::JoystickHelper> fcpp::io::manager::joystic
 #ifdef FCPP_IO_RAYLIB
     if (idx == counter++) return std::make_unique<fcpp::io::RayLibController::JoystickHelper>();
 #endif
+    if (idx == counter) return std::make_unique<fcpp::io::NullController::JoystickHelper>();
     return nullptr;
 }
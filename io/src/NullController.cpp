@@ -0,0 +1,369 @@
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FCPP/IO/Audio.hpp"
+#include "FCPP/IO/Input.hpp"
+#include "FCPP/IO/Video.hpp"
+#include "FCPP/IO/Null/NullController.hpp"
+
+namespace fcpp::io::detail
+{
+    class NullScript
+    {
+    public:
+        NullScript() = default;
+        ~NullScript() = default;
+
+        bool load(const char* path);
+        // input for frame, entries must be visited in order
+        void seek(std::uint32_t frame) noexcept;
+        std::uint8_t get(int idx) const noexcept;
+    private:
+        struct Entry
+        {
+            std::uint32_t frame;
+            std::uint8_t input[2];
+        };
+    private:
+        std::size_t next = 0;
+        std::uint8_t input[2]{};
+        std::vector<Entry> entries{};
+    };
+    bool NullScript::load(const char* const path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+
+        std::vector<Entry> script{};
+        std::string line{};
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream fields(line);
+            unsigned int frame = 0, input0 = 0, input1 = 0;
+            if (!(fields >> frame >> std::hex >> input0 >> input1)) return false;
+            if (!script.empty() && frame < script.back().frame) return false;
+            script.push_back({ frame, { static_cast<std::uint8_t>(input0), static_cast<std::uint8_t>(input1) } });
+        }
+
+        entries = std::move(script);
+        next = 0;
+        input[0] = input[1] = 0;
+        return true;
+    }
+    void NullScript::seek(const std::uint32_t frame) noexcept
+    {
+        for (; next < entries.size() && entries[next].frame <= frame; next++)
+        {
+            input[0] = entries[next].input[0];
+            input[1] = entries[next].input[1];
+        }
+    }
+    std::uint8_t NullScript::get(const int idx) const noexcept
+    {
+        return input[idx];
+    }
+
+    class NullVideo : public Video
+    {
+    public:
+        NullVideo() noexcept;
+        ~NullVideo() override = default;
+
+        void render() noexcept;
+        bool setVideoDump(const char* path) noexcept;
+        void setVideoFilter(VideoFilter::Type type, int scale, int threads);
+        void setScript(NullScript* s) noexcept;
+        std::uint32_t getFrameCount() const noexcept;
+        void setFrameBufferData(const std::uint8_t* data) noexcept;
+        void getFrameBufferData(std::uint8_t* data) const noexcept;
+    private:
+        void setPixel(int x, int y, std::uint32_t color) noexcept override;
+        void completedSignal() noexcept override;
+        bool keepsLastFrame() noexcept override;
+    private:
+        std::uint32_t frame = 0;
+        NullScript* script = nullptr;
+        std::ofstream dump{};
+        VideoFilter filter{};
+        std::uint32_t frameBuffer[256 * 240]{};
+    };
+    NullVideo::NullVideo() noexcept
+    {
+        // unlimited, the limiter still keeps the frame time stats
+        fpsLimiter.set(500.0);
+    }
+    void NullVideo::render() noexcept
+    {
+        if (renderCallback) renderCallback();
+        fpsLimiter.FPSLimiter::wait();
+    }
+    bool NullVideo::setVideoDump(const char* const path) noexcept
+    {
+        if (dump.is_open()) dump.close();
+        if (path == nullptr) return true;
+        dump.open(path, std::ios::binary);
+        return dump.is_open();
+    }
+    void NullVideo::setVideoFilter(const VideoFilter::Type type, const int scale, const int threads)
+    {
+        filter.set(type, scale, threads);
+    }
+    void NullVideo::setScript(NullScript* const s) noexcept
+    {
+        script = s;
+        script->seek(frame);
+    }
+    std::uint32_t NullVideo::getFrameCount() const noexcept
+    {
+        return frame;
+    }
+    void NullVideo::setFrameBufferData(const std::uint8_t* const data) noexcept
+    {
+        if (data != nullptr) std::memcpy(frameBuffer, data, Controller::FrameBufferSize);
+    }
+    void NullVideo::getFrameBufferData(std::uint8_t* const data) const noexcept
+    {
+        if (data != nullptr) std::memcpy(data, frameBuffer, Controller::FrameBufferSize);
+    }
+    void NullVideo::setPixel(const int x, const int y, const std::uint32_t color) noexcept
+    {
+        frameBuffer[static_cast<std::size_t>(256) * y + x] = color;
+    }
+    void NullVideo::completedSignal() noexcept
+    {
+        if (dump.is_open())
+        {
+            auto frame = filter.process(frameBuffer);
+            dump.write(reinterpret_cast<const char*>(frame), sizeof(std::uint32_t) * filter.getWidth() * filter.getHeight());
+        }
+        if (script != nullptr) script->seek(++frame);
+        else ++frame;
+
+        if (frameCompletedCallback) frameCompletedCallback();
+        else render();
+    }
+    bool NullVideo::keepsLastFrame() noexcept
+    {
+        return true;
+    }
+
+    class NullInput : public Input
+    {
+    public:
+        NullInput() = default;
+        ~NullInput() override = default;
+
+        void set(const NullScript* s, int i) noexcept;
+    private:
+        std::uint8_t scan() noexcept override;
+    private:
+        int idx = 0;
+        const NullScript* script = nullptr;
+    };
+    void NullInput::set(const NullScript* const s, const int i) noexcept
+    {
+        script = s;
+        idx = i;
+    }
+    std::uint8_t NullInput::scan() noexcept
+    {
+        return script->get(idx);
+    }
+
+    class NullAudio : public Audio
+    {
+    public:
+        NullAudio() = default;
+        ~NullAudio() override = default;
+
+        bool setAudioDump(const char* path) noexcept;
+        void setVolume(double v) noexcept;
+    private:
+        void sendSample(double sample) noexcept override;
+    private:
+        double volume = 1.0;
+        std::ofstream dump{};
+    };
+    bool NullAudio::setAudioDump(const char* const path) noexcept
+    {
+        if (dump.is_open()) dump.close();
+        if (path == nullptr) return true;
+        dump.open(path, std::ios::binary);
+        return dump.is_open();
+    }
+    void NullAudio::setVolume(const double v) noexcept
+    {
+        volume = v < 0.0 ? 0.0 : (100.0f < v ? 1.0 : v / 100.0);
+    }
+    void NullAudio::sendSample(const double sample) noexcept
+    {
+        if (!dump.is_open()) return;
+        auto value = static_cast<std::int16_t>(sample * 32767 * volume);
+        dump.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+struct fcpp::io::NullController::NullControllerData
+{
+    detail::NullScript script{};
+    detail::NullVideo video{};
+    detail::NullInput input[2]{};
+    detail::NullAudio audio{};
+};
+
+fcpp::io::NullController::NullController() : dptr(std::make_unique<NullControllerData>())
+{
+    dptr->video.setScript(&dptr->script);
+    for (int i = 0; i < 2; i++) dptr->input[i].set(&dptr->script, i);
+}
+fcpp::io::NullController::~NullController() noexcept = default;
+
+bool fcpp::io::NullController::setVideoDump(const char* const path) noexcept
+{
+    return dptr->video.setVideoDump(path);
+}
+bool fcpp::io::NullController::setAudioDump(const char* const path) noexcept
+{
+    return dptr->audio.setAudioDump(path);
+}
+bool fcpp::io::NullController::setInputScript(const char* const path) noexcept
+{
+    if (!dptr->script.load(path)) return false;
+    dptr->video.setScript(&dptr->script);
+    return true;
+}
+std::uint32_t fcpp::io::NullController::getFrameCount() const noexcept
+{
+    return dptr->video.getFrameCount();
+}
+bool fcpp::io::NullController::create() noexcept
+{
+    return true;
+}
+fcpp::core::FrameBuffer* fcpp::io::NullController::getFrameBuffer() noexcept
+{
+    return &dptr->video;
+}
+fcpp::core::InputScanner* fcpp::io::NullController::getInputScanner(const int idx) noexcept
+{
+    return &dptr->input[idx];
+}
+fcpp::core::SampleBuffer* fcpp::io::NullController::getSampleBuffer() noexcept
+{
+    return &dptr->audio;
+}
+void fcpp::io::NullController::render() noexcept
+{
+    dptr->video.render();
+}
+void fcpp::io::NullController::setPresentThread(bool /* enable */) noexcept {}
+bool fcpp::io::NullController::setFullScreen(bool /* enable */) noexcept
+{
+    return true;
+}
+bool fcpp::io::NullController::setBorderless(bool /* enable */) noexcept
+{
+    return true;
+}
+bool fcpp::io::NullController::setVerticalSync(bool /* enable */) noexcept
+{
+    return true;
+}
+bool fcpp::io::NullController::setRenderDriver(int /* idx */) noexcept
+{
+    return true;
+}
+bool fcpp::io::NullController::setJoystickPort(int /* idx */, int /* port */) noexcept
+{
+    return true;
+}
+void fcpp::io::NullController::setScale(float /* factor */) noexcept {}
+void fcpp::io::NullController::setVideoFilter(const VideoFilter::Type type, const int scale, const int threads)
+{
+    dptr->video.setVideoFilter(type, scale, threads);
+}
+void fcpp::io::NullController::setTitle(const char* /* text */) noexcept {}
+void fcpp::io::NullController::setFPSLimit(const double fps) noexcept
+{
+    dptr->video.setFPSLimit(fps);
+}
+void fcpp::io::NullController::setAudioSync(bool /* enable */) noexcept {}
+fcpp::io::Controller::PacingStats fcpp::io::NullController::getPacingStats() noexcept
+{
+    return dptr->video.getPacingStats();
+}
+void fcpp::io::NullController::setOverlay(const float* /* values */, int /* count */) noexcept {}
+void fcpp::io::NullController::setVolume(const float volume) noexcept
+{
+    dptr->audio.setVolume(volume);
+}
+void fcpp::io::NullController::setSampleRate(const int rate) noexcept
+{
+    dptr->audio.setSampleRate(rate);
+}
+void fcpp::io::NullController::setJoypadType(const int idx, const fcpp::core::JoypadType type) noexcept
+{
+    dptr->input[idx].setJoypadType(type);
+}
+void fcpp::io::NullController::setPaletteTable(const PaletteTable& paletteTable) noexcept
+{
+    dptr->video.setPaletteTable(paletteTable);
+}
+void fcpp::io::NullController::setPaletteTable(PaletteTable&& paletteTable) noexcept
+{
+    dptr->video.setPaletteTable(std::move(paletteTable));
+}
+void fcpp::io::NullController::setTurboButtonSpeed(const int idx, const std::uint8_t v) noexcept
+{
+    dptr->input[idx].setTurboSpeed(v);
+}
+void fcpp::io::NullController::setFrameBufferData(const std::uint8_t* const argb) noexcept
+{
+    dptr->video.setFrameBufferData(argb);
+}
+void fcpp::io::NullController::getFrameBufferData(std::uint8_t* const argb) const noexcept
+{
+    dptr->video.getFrameBufferData(argb);
+}
+void fcpp::io::NullController::bind(int /* idx */, int /* standardButtonIdx */, Keyboard /* key */) noexcept {}
+void fcpp::io::NullController::bind(int /* idx */, int /* standardButtonIdx */, Joystick /* button */) noexcept {}
+void fcpp::io::NullController::setKeyPressCallback(std::function<void(Keyboard)> callback) noexcept
+{
+    dptr->video.setKeyPressCallback(std::move(callback));
+}
+void fcpp::io::NullController::setFrameCompleteCallback(std::function<void()> callback) noexcept
+{
+    dptr->video.setFrameCompleteCallback(std::move(callback));
+}
+void fcpp::io::NullController::setRenderCallback(std::function<void()> callback) noexcept
+{
+    dptr->video.setRenderCallback(std::move(callback));
+}
+void fcpp::io::NullController::setCloseCallback(std::function<void()> callback) noexcept
+{
+    dptr->video.setCloseCallback(std::move(callback));
+}
+
+int fcpp::io::NullController::Info::getRenderDriverCount() noexcept
+{
+    return 1;
+}
+const char* fcpp::io::NullController::Info::getRenderDriverName(int /* idx */) noexcept
+{
+    return "none";
+}
+
+bool fcpp::io::NullController::JoystickHelper::joystickPressed(int /* port */, fcpp::io::Joystick& buttons) noexcept
+{
+    buttons = Joystick::Unknown;
+    return false;
+}
+int fcpp::io::NullController::JoystickHelper::joystickCount() noexcept
+{
+    return 0;
+}
@@ -1,4 +1,6 @@
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 #include <string>
 #include <utility>
@@ -234,12 +236,23 @@ namespace fcpp::io::detail
         bool setBorderless(bool enable) noexcept;
         bool setVerticalSync(bool enable) noexcept;
         void setScale(double factor) noexcept;
+        void setVideoFilter(VideoFilter::Type type, int scale, int threads);
         void setTitle(const char* text) noexcept;
         void setFrameBufferData(const std::uint8_t* data) noexcept;
         void getFrameBufferData(std::uint8_t* data) const noexcept;
     private:
         void setPixel(int x, int y, std::uint32_t color) noexcept override;
         void completedSignal() noexcept override;
+        bool keepsLastFrame() noexcept override;
+        void setFrameUnchanged(bool unchanged) noexcept override;
+    private:
+        bool createWindow() noexcept;
+        void destroyWindow() noexcept;
+        // false if the window should close
+        bool pollEvents() noexcept;
+        void draw(bool upload) noexcept;
+        void present() noexcept;
+        void createTexture() noexcept;
     private:
         Texture2D texture{};
 
@@ -247,18 +260,23 @@ namespace fcpp::io::detail
         int width = 256, height = 240;
         unsigned int windowMode = 0;
         std::string title{ "FCPP RayLib Renderer" };
-        Color frameBuffer[256 * 240]{};
+        bool unchangedFrame = false;
+        VideoFilter filter{ VideoFilter::PixelFormat::RGBA };
+        fcpp::util::TripleBuffer<std::array<Color, 256 * 240>> frames{};
     };
 
     RayLibVideo::~RayLibVideo() noexcept
     {
-        if (IsWindowReady())
-        {
-            UnloadTexture(texture);
-            CloseWindow();
-        }
+        stopPresentThread();
+        destroyWindow();
     }
     bool RayLibVideo::create() noexcept
+    {
+        if (presentThreadFlag)
+            return startPresentThread([this]() { return createWindow(); }, [this]() { present(); }, [this]() { destroyWindow(); });
+        return createWindow();
+    }
+    bool RayLibVideo::createWindow() noexcept
     {
         if (!IsWindowReady())
         {
@@ -277,44 +295,97 @@ namespace fcpp::io::detail
             else ClearWindowState(FLAG_VSYNC_HINT);
             SetWindowState(FLAG_WINDOW_RESIZABLE);
             SetExitKey(KEY_NULL);
-            auto image = GenImageColor(256, 240, WHITE);
-            texture = LoadTextureFromImage(image);
-            UnloadImage(image);
+            createTexture();
 
             return IsWindowReady();
         }
         return false;
     }
+    void RayLibVideo::destroyWindow() noexcept
+    {
+        if (IsWindowReady())
+        {
+            UnloadTexture(texture);
+            CloseWindow();
+        }
+    }
+    void RayLibVideo::createTexture() noexcept
+    {
+        auto image = GenImageColor(filter.getWidth(), filter.getHeight(), WHITE);
+        texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+    }
     void RayLibVideo::render() noexcept
     {
-        if (!WindowShouldClose())
+        if (presenting())
         {
-            if (IsWindowResized())
-            {
-                width = GetRenderWidth();
-                height = GetRenderHeight();
-            }
-
-            if (keyPressCallback)
-                if (auto key = GetKeyPressed()) keyPressCallback(keyMap(key));
+            if (renderCallback) renderCallback();
+            fpsLimiter.FPSLimiter::wait();
+            return;
+        }
 
+        if (pollEvents())
+        {
             if (renderCallback) renderCallback();
 
-            UpdateTexture(texture, frameBuffer);
+            draw(frames.update());
+        }
+    }
+    bool RayLibVideo::pollEvents() noexcept
+    {
+        if (WindowShouldClose())
+        {
+            if (closeCallback) closeCallback();
+            return false;
+        }
+
+        if (IsWindowResized())
+        {
+            width = GetRenderWidth();
+            height = GetRenderHeight();
+        }
+
+        if (keyPressCallback)
+            if (auto key = GetKeyPressed()) keyPressCallback(keyMap(key));
 
-            BeginDrawing();
+        return true;
+    }
+    void RayLibVideo::draw(const bool upload) noexcept
+    {
+        if (upload)
+        {
+            auto frame = reinterpret_cast<const std::uint32_t*>(frames.front().data());
+            if (filter.getType() != VideoFilter::Type::None)
             {
-                DrawTexturePro(texture,
-                    { 0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height) },
-                    { 0.0f, 0.0f, static_cast<float>(GetRenderWidth()), static_cast<float>(GetRenderHeight()) },
-                    { 0, 0 }, 0, WHITE);
+                fcpp::util::Trace::Scope scope{ "video filter" };
+                frame = filter.process(frame);
             }
-            EndDrawing();
+            UpdateTexture(texture, frame);
+        }
+
+        BeginDrawing();
+        {
+            DrawTexturePro(texture,
+                { 0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height) },
+                { 0.0f, 0.0f, static_cast<float>(GetRenderWidth()), static_cast<float>(GetRenderHeight()) },
+                { 0, 0 }, 0, WHITE);
         }
-        else if (closeCallback) closeCallback();
+        EndDrawing();
+    }
+    void RayLibVideo::present() noexcept
+    {   // input events are polled by EndDrawing, so the window is redrawn even without a new frame
+        if (!pollEvents())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return;
+        }
+        auto fresh = frames.update();
+        if (!fresh && !vsync) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        draw(fresh);
     }
     bool RayLibVideo::setFullScreen(const bool enable) noexcept
     {
+        if (post([this, enable]() { setFullScreen(enable); })) return true;
         windowMode = enable ? FLAG_FULLSCREEN_MODE : 0;
         if (IsWindowReady())
         {
@@ -335,6 +406,7 @@ namespace fcpp::io::detail
     }
     bool RayLibVideo::setBorderless(const bool enable) noexcept
     {
+        if (post([this, enable]() { setBorderless(enable); })) return true;
         windowMode = enable ? FLAG_WINDOW_UNDECORATED : 0;
         if (IsWindowReady())
         {
@@ -355,6 +427,7 @@ namespace fcpp::io::detail
     }
     bool RayLibVideo::setVerticalSync(const bool enable) noexcept
     {
+        if (post([this, enable]() { setVerticalSync(enable); })) return true;
         vsync = enable;
         if (IsWindowReady())
         {
@@ -366,39 +439,69 @@ namespace fcpp::io::detail
     }
     void RayLibVideo::setScale(const double factor) noexcept
     {
+        if (post([this, factor]() { setScale(factor); })) return;
         width = static_cast<int>(256.0 * factor);
         height = static_cast<int>(240.0 * factor);
         if (IsWindowReady()) SetWindowSize(width, height);
     }
+    void RayLibVideo::setVideoFilter(const VideoFilter::Type type, const int scale, const int threads)
+    {
+        if (post([this, type, scale, threads]() { setVideoFilter(type, scale, threads); })) return;
+        filter.set(type, scale, threads);
+        if (IsWindowReady())
+        {
+            UnloadTexture(texture);
+            createTexture();
+        }
+    }
     void RayLibVideo::setTitle(const char* const text) noexcept
     {
+        if (post([this, text = std::string{ text }]() { setTitle(text.c_str()); })) return;
         title = text;
         if (IsWindowReady()) SetWindowTitle(text);
     }
     void RayLibVideo::setFrameBufferData(const std::uint8_t* const data) noexcept
     {
-        if (data != nullptr) std::memcpy(frameBuffer, data, Controller::FrameBufferSize);
+        if (data == nullptr) return;
+        std::memcpy(frames.back().data(), data, Controller::FrameBufferSize);
+        frames.publish();
     }
     void RayLibVideo::getFrameBufferData(std::uint8_t* const data) const noexcept
     {
-        if (data != nullptr) std::memcpy(data, frameBuffer, Controller::FrameBufferSize);
+        if (data != nullptr) std::memcpy(data, frames.last().data(), Controller::FrameBufferSize);
     }
     void RayLibVideo::setPixel(const int x, const int y, const std::uint32_t color) noexcept
     {
-        frameBuffer[static_cast<std::size_t>(256) * y + x].r = (color >> 16) & 0xff;
-        frameBuffer[static_cast<std::size_t>(256) * y + x].g = (color >> 8) & 0xff;
-        frameBuffer[static_cast<std::size_t>(256) * y + x].b = color & 0xff;
-        frameBuffer[static_cast<std::size_t>(256) * y + x].a = 0xff;
+        auto& pixel = frames.back()[static_cast<std::size_t>(256) * y + x];
+        pixel.r = (color >> 16) & 0xff;
+        pixel.g = (color >> 8) & 0xff;
+        pixel.b = color & 0xff;
+        pixel.a = 0xff;
     }
     void RayLibVideo::completedSignal() noexcept
-    {
+    {   // an unchanged frame is already the last published one
+        if (!unchangedFrame) frames.publish();
         if (frameCompletedCallback) frameCompletedCallback();
+        else if (presenting())
+        {
+            if (renderCallback) renderCallback();
+            fpsLimiter.wait();
+        }
         else
         {
             render();
             fpsLimiter.wait();
         }
     }
+    bool RayLibVideo::keepsLastFrame() noexcept
+    {
+        frames.back() = frames.last();
+        return true;
+    }
+    void RayLibVideo::setFrameUnchanged(const bool unchanged) noexcept
+    {
+        unchangedFrame = unchanged;
+    }
 
     class RayLibInput : public Input
     {
@@ -530,6 +633,7 @@ namespace fcpp::io::detail
 
         bool create() noexcept;
         void setVolume(float v) noexcept;
+        double getFillLevel() const noexcept;
     private:
         void sendSample(double sample) noexcept override;
     private:
@@ -573,6 +677,10 @@ namespace fcpp::io::detail
     {
         SetMasterVolume(v < 0.0f ? 0.0f : (100.0f < v ? 1.0f : v / 100.0f));
     }
+    double RayLibAudio::getFillLevel() const noexcept
+    {
+        return static_cast<double>(frames * buffSize + writeCount) / (buffSize * buffNum);
+    }
     void RayLibAudio::sendSample(const double sample) noexcept
     {
         if (frames < buffNum)
@@ -643,6 +751,10 @@ void fcpp::io::RayLibController::render() noexcept
 {
     dptr->video.render();
 }
+void fcpp::io::RayLibController::setPresentThread(const bool enable) noexcept
+{
+    dptr->video.setPresentThread(enable);
+}
 bool fcpp::io::RayLibController::setFullScreen(const bool enable) noexcept
 {
     return dptr->video.setFullScreen(enable);
@@ -667,6 +779,10 @@ void fcpp::io::RayLibController::setScale(const float factor) noexcept
 {
     dptr->video.setScale(factor);
 }
+void fcpp::io::RayLibController::setVideoFilter(const VideoFilter::Type type, const int scale, const int threads)
+{
+    dptr->video.setVideoFilter(type, scale, threads);
+}
 void fcpp::io::RayLibController::setTitle(const char* const text) noexcept
 {
     dptr->video.setTitle(text);
@@ -675,6 +791,16 @@ void fcpp::io::RayLibController::setFPSLimit(const double fps) noexcept
 {
     dptr->video.setFPSLimit(fps);
 }
+void fcpp::io::RayLibController::setAudioSync(const bool enable) noexcept
+{
+    if (enable) dptr->video.setAudioClock([this]() { return dptr->audio.getFillLevel(); });
+    else dptr->video.setAudioClock(nullptr);
+}
+fcpp::io::Controller::PacingStats fcpp::io::RayLibController::getPacingStats() noexcept
+{
+    return dptr->video.getPacingStats();
+}
+void fcpp::io::RayLibController::setOverlay(const float* /* values */, int /* count */) noexcept {}
 void fcpp::io::RayLibController::setVolume(const float volume) noexcept
 {
     dptr->audio.setVolume(volume);
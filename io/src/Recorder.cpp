@@ -0,0 +1,329 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "FCPP/IO/Recorder.hpp"
+#include "FCPP/Util/SPSCRing.hpp"
+#include "FCPP/Util/Trace.hpp"
+
+namespace fcpp::io::detail
+{
+    // a kept frame, if any, and the samples since the last chunk
+    struct RecorderChunk
+    {
+        bool video = false;
+        std::uint32_t frame[256 * 240]{};
+        std::vector<std::int16_t> samples{};
+    };
+
+    class RecorderWriter
+    {
+    public:
+        RecorderWriter() = default;
+        ~RecorderWriter() = default;
+
+        bool open(const char* videoPath, Recorder::VideoFormat format, const char* audioPath, int decimation, int sampleRate);
+        void write(const RecorderChunk& chunk);
+        void close() noexcept;
+        bool hasVideo() const noexcept;
+        bool hasAudio() const noexcept;
+    private:
+        template<typename T>
+        void put(T value);
+    private:
+        Recorder::VideoFormat format = Recorder::VideoFormat::Y4M;
+        std::uint32_t audioSize = 0;
+        std::ofstream video{};
+        std::ofstream audio{};
+        std::vector<std::uint8_t> buffer{};
+    };
+    bool RecorderWriter::open(const char* const videoPath, const Recorder::VideoFormat f, const char* const audioPath, const int decimation, const int sampleRate)
+    {
+        format = f;
+        audioSize = 0;
+        if (videoPath != nullptr)
+        {
+            video.open(videoPath, std::ios::binary);
+            if (!video.is_open()) return false;
+            // 60.0988 fps, the NTSC frame rate, and the 8:7 pixel aspect ratio
+            if (format == Recorder::VideoFormat::Y4M)
+                video << "YUV4MPEG2 W256 H240 F39375000:" << 655171ull * decimation << " Ip A8:7 C444\n";
+            buffer.resize(256 * 240 * 3);
+        }
+        if (audioPath != nullptr)
+        {
+            audio.open(audioPath, std::ios::binary);
+            if (!audio.is_open())
+            {
+                close();
+                return false;
+            }
+            // 16-bit mono PCM, the sizes are patched by close()
+            audio.write("RIFF", 4);
+            put<std::uint32_t>(36);
+            audio.write("WAVEfmt ", 8);
+            put<std::uint32_t>(16);
+            put<std::uint16_t>(1);
+            put<std::uint16_t>(1);
+            put<std::uint32_t>(sampleRate);
+            put<std::uint32_t>(sampleRate * 2);
+            put<std::uint16_t>(2);
+            put<std::uint16_t>(16);
+            audio.write("data", 4);
+            put<std::uint32_t>(0);
+        }
+        return true;
+    }
+    void RecorderWriter::write(const RecorderChunk& chunk)
+    {
+        if (chunk.video && video.is_open())
+        {
+            auto data = buffer.data();
+            if (format == Recorder::VideoFormat::Y4M)
+            {
+                // BT.601 limited range, one plane after another
+                constexpr std::size_t PlaneSize = 256 * 240;
+                for (std::size_t i = 0; i < PlaneSize; i++)
+                {
+                    int r = (chunk.frame[i] >> 16) & 0xff, g = (chunk.frame[i] >> 8) & 0xff, b = chunk.frame[i] & 0xff;
+                    data[i] = static_cast<std::uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+                    data[i + PlaneSize] = static_cast<std::uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                    data[i + PlaneSize * 2] = static_cast<std::uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+                }
+                video.write("FRAME\n", 6);
+            }
+            else for (auto color : chunk.frame)
+            {
+                *data++ = static_cast<std::uint8_t>(color >> 16);
+                *data++ = static_cast<std::uint8_t>(color >> 8);
+                *data++ = static_cast<std::uint8_t>(color);
+            }
+            video.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        }
+        if (!chunk.samples.empty() && audio.is_open())
+        {
+            // WAV is little endian, as are the hosts the emulator runs on
+            auto size = chunk.samples.size() * sizeof(std::int16_t);
+            audio.write(reinterpret_cast<const char*>(chunk.samples.data()), static_cast<std::streamsize>(size));
+            audioSize += static_cast<std::uint32_t>(size);
+        }
+    }
+    void RecorderWriter::close() noexcept
+    {
+        if (video.is_open()) video.close();
+        if (audio.is_open())
+        {
+            audio.seekp(4);
+            put<std::uint32_t>(36 + audioSize);
+            audio.seekp(40);
+            put<std::uint32_t>(audioSize);
+            audio.close();
+        }
+    }
+    bool RecorderWriter::hasVideo() const noexcept
+    {
+        return video.is_open();
+    }
+    bool RecorderWriter::hasAudio() const noexcept
+    {
+        return audio.is_open();
+    }
+    template<typename T>
+    void RecorderWriter::put(const T value)
+    {
+        char bytes[sizeof(T)]{};
+        for (std::size_t i = 0; i < sizeof(T); i++) bytes[i] = static_cast<char>(static_cast<std::uint32_t>(value) >> (i * 8));
+        audio.write(bytes, sizeof(T));
+    }
+
+    class RecorderTap :
+        public fcpp::core::FrameBuffer,
+        public fcpp::core::SampleBuffer
+    {
+    public:
+        static constexpr std::size_t MaxStagedSamples = 1 << 14;
+        static constexpr std::size_t QueueSize = 32;
+    public:
+        RecorderTap() = default;
+        ~RecorderTap() override = default;
+
+        void setPixel(int x, int y, std::uint32_t color) noexcept override;
+        void completedSignal() noexcept override;
+        const std::uint32_t* getPaletteTable() noexcept override;
+        bool keepsLastFrame() noexcept override;
+        void setFrameUnchanged(bool unchanged) noexcept override;
+
+        void sendSample(double sample) noexcept override;
+        int getSampleRate() noexcept override;
+
+        // queue the staged samples and the current frame if keep, false if the ring is full and it may not wait
+        bool queue(bool keep, bool wait) noexcept;
+    public:
+        fcpp::core::FrameBuffer* frameBuffer = nullptr;
+        fcpp::core::SampleBuffer* sampleBuffer = nullptr;
+        std::atomic<bool> recording{ false };
+        bool video = false, audio = false, blocking = false;
+        int sampleRate = 44100;
+        int decimation = 1;
+        std::uint32_t count = 0;
+        std::atomic<std::uint32_t> frames{ 0 }, dropped{ 0 };
+        std::vector<std::int16_t> samples{};
+        fcpp::util::SPSCRing<RecorderChunk, QueueSize> ring{};
+        std::uint32_t frame[256 * 240]{};
+    };
+    void RecorderTap::setPixel(const int x, const int y, const std::uint32_t color) noexcept
+    {
+        frame[static_cast<std::size_t>(256) * y + x] = color;
+        if (frameBuffer != nullptr) frameBuffer->setPixel(x, y, color);
+    }
+    void RecorderTap::completedSignal() noexcept
+    {
+        if (recording.load(std::memory_order_relaxed))
+        {
+            bool keep = video && count++ % decimation == 0;
+            if (!queue(keep, blocking) && keep) dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (frameBuffer != nullptr) frameBuffer->completedSignal();
+    }
+    const std::uint32_t* RecorderTap::getPaletteTable() noexcept
+    {
+        return frameBuffer != nullptr ? frameBuffer->getPaletteTable() : nullptr;
+    }
+    bool RecorderTap::keepsLastFrame() noexcept
+    {
+        // the tap keeps its own copy, so it is up to the output
+        return frameBuffer == nullptr || frameBuffer->keepsLastFrame();
+    }
+    void RecorderTap::setFrameUnchanged(const bool unchanged) noexcept
+    {
+        if (frameBuffer != nullptr) frameBuffer->setFrameUnchanged(unchanged);
+    }
+    void RecorderTap::sendSample(const double sample) noexcept
+    {
+        if (audio && recording.load(std::memory_order_relaxed))
+        {
+            auto value = sample < -1.0 ? -1.0 : (1.0 < sample ? 1.0 : sample);
+            samples.push_back(static_cast<std::int16_t>(value * 32767));
+            // no frames while the machine is stopped or video is disconnected
+            if (samples.size() >= MaxStagedSamples) queue(false, blocking);
+        }
+        if (sampleBuffer != nullptr) sampleBuffer->sendSample(sample);
+    }
+    int RecorderTap::getSampleRate() noexcept
+    {
+        sampleRate = sampleBuffer != nullptr ? sampleBuffer->getSampleRate() : 44100;
+        return sampleRate;
+    }
+    bool RecorderTap::queue(const bool keep, const bool wait) noexcept
+    {
+        if (!keep && samples.empty()) return true;
+
+        RecorderChunk* chunk = nullptr;
+        while ((chunk = ring.back()) == nullptr)
+        {
+            // the samples stay staged for the next chunk
+            if (!wait) return false;
+            std::this_thread::yield();
+        }
+        chunk->video = keep;
+        if (keep) std::memcpy(chunk->frame, frame, sizeof(frame));
+        // the buffers go back and forth between the tap and the ring, no allocations once they have grown
+        chunk->samples.swap(samples);
+        samples.clear();
+        ring.push();
+        if (keep) frames.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+}
+
+struct fcpp::io::Recorder::RecorderData
+{
+    detail::RecorderTap tap{};
+    detail::RecorderWriter writer{};
+    std::atomic<bool> quit{ false };
+    std::thread thread{};
+
+    void run() noexcept
+    {
+        fcpp::util::Trace::setThreadName("recorder");
+        for (;;)
+        {
+            // everything queued before quit is seen
+            bool done = quit.load(std::memory_order_acquire);
+            auto chunk = tap.ring.front();
+            if (chunk == nullptr)
+            {
+                if (done) break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            fcpp::util::Trace::Scope scope{ "record" };
+            writer.write(*chunk);
+            tap.ring.pop();
+        }
+    }
+};
+
+fcpp::io::Recorder::Recorder() : dptr(std::make_unique<RecorderData>()) {}
+fcpp::io::Recorder::~Recorder() noexcept
+{
+    stop();
+}
+
+fcpp::core::FrameBuffer* fcpp::io::Recorder::tap(fcpp::core::FrameBuffer* const output) noexcept
+{
+    dptr->tap.frameBuffer = output;
+    return &dptr->tap;
+}
+fcpp::core::SampleBuffer* fcpp::io::Recorder::tap(fcpp::core::SampleBuffer* const output) noexcept
+{
+    dptr->tap.sampleBuffer = output;
+    return &dptr->tap;
+}
+void fcpp::io::Recorder::setBlocking(const bool enable) noexcept
+{
+    dptr->tap.blocking = enable;
+}
+bool fcpp::io::Recorder::start(const char* const videoPath, const VideoFormat format, const char* const audioPath, const int decimation)
+{
+    stop();
+    if (!dptr->writer.open(videoPath, format, audioPath, decimation > 1 ? decimation : 1, dptr->tap.sampleRate)) return false;
+
+    auto& tap = dptr->tap;
+    tap.video = dptr->writer.hasVideo();
+    tap.audio = dptr->writer.hasAudio();
+    tap.decimation = decimation > 1 ? decimation : 1;
+    tap.count = 0;
+    tap.frames = tap.dropped = 0;
+    tap.samples.clear();
+    dptr->quit.store(false, std::memory_order_relaxed);
+    dptr->thread = std::thread{ &RecorderData::run, dptr.get() };
+    tap.recording.store(true, std::memory_order_relaxed);
+    return true;
+}
+void fcpp::io::Recorder::stop() noexcept
+{
+    if (!dptr->tap.recording.load(std::memory_order_relaxed)) return;
+    dptr->tap.recording.store(false, std::memory_order_relaxed);
+
+    // the audio after the last frame is never dropped
+    dptr->tap.queue(false, true);
+    dptr->quit.store(true, std::memory_order_release);
+    dptr->thread.join();
+    dptr->writer.close();
+}
+bool fcpp::io::Recorder::isRecording() const noexcept
+{
+    return dptr->tap.recording.load(std::memory_order_relaxed);
+}
+std::uint32_t fcpp::io::Recorder::getFrameCount() const noexcept
+{
+    return dptr->tap.frames.load(std::memory_order_relaxed);
+}
+std::uint32_t fcpp::io::Recorder::getDroppedFrames() const noexcept
+{
+    return dptr->tap.dropped.load(std::memory_order_relaxed);
+}
@@ -1,7 +1,10 @@
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <SDL.h>
 
@@ -10,6 +13,7 @@
 #include "FCPP/IO/Video.hpp"
 #include "FCPP/IO/SDL2/SDL2Controller.hpp"
 #include "FCPP/Util/LoopCounter.hpp"
+#include "FCPP/Util/Trace.hpp"
 
 namespace fcpp::io::detail
 {
@@ -274,12 +278,23 @@ namespace fcpp::io::detail
         bool setVerticalSync(bool enable) noexcept;
         bool setRenderDriver(int idx) noexcept;
         void setScale(double factor) noexcept;
+        void setVideoFilter(VideoFilter::Type type, int scale, int threads);
         void setTitle(const char* text) noexcept;
+        void setOverlay(std::vector<float> values) noexcept;
         void setFrameBufferData(const std::uint8_t* data) noexcept;
         void getFrameBufferData(std::uint8_t* data) const noexcept;
     private:
         void setPixel(int x, int y, std::uint32_t color) noexcept override;
         void completedSignal() noexcept override;
+        bool keepsLastFrame() noexcept override;
+        void setFrameUnchanged(bool unchanged) noexcept override;
+    private:
+        bool createWindow() noexcept;
+        void destroyWindow() noexcept;
+        void pollEvents() noexcept;
+        void draw(bool upload) noexcept;
+        void drawOverlay() noexcept;
+        void present() noexcept;
     private:
         SDL_Window* window = nullptr;
         SDL_Renderer* renderer = nullptr;
@@ -290,15 +305,23 @@ namespace fcpp::io::detail
         int renderDriverIdx = -1;
         std::uint32_t windowMode = 0;
         std::string title{ "FCPP SDL2 Renderer" };
-        std::uint32_t frameBuffer[256 * 240]{};
+        std::vector<float> overlay{};
+        bool unchangedFrame = false;
+        VideoFilter filter{};
+        fcpp::util::TripleBuffer<std::array<std::uint32_t, 256 * 240>> frames{};
     };
     SDL2Video::~SDL2Video() noexcept
     {
-        if (texture != nullptr) SDL_DestroyTexture(texture);
-        if (renderer != nullptr) SDL_DestroyRenderer(renderer);
-        if (window != nullptr) SDL_DestroyWindow(window);
+        stopPresentThread();
+        destroyWindow();
     }
     bool SDL2Video::create() noexcept
+    {
+        if (presentThreadFlag)
+            return startPresentThread([this]() { return createWindow(); }, [this]() { present(); }, [this]() { destroyWindow(); });
+        return createWindow();
+    }
+    bool SDL2Video::createWindow() noexcept
     {
         if (window == nullptr)
         {
@@ -321,7 +344,7 @@ namespace fcpp::io::detail
         }
         if (texture == nullptr)
         {
-            texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 256, 240);
+            texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, filter.getWidth(), filter.getHeight());
             if (texture == nullptr)
             {
                 SDL_Log("SDL_CreateTexture Error: %s\n", SDL_GetError());
@@ -331,7 +354,31 @@ namespace fcpp::io::detail
 
         return true;
     }
+    void SDL2Video::destroyWindow() noexcept
+    {
+        if (texture != nullptr) SDL_DestroyTexture(texture);
+        if (renderer != nullptr) SDL_DestroyRenderer(renderer);
+        if (window != nullptr) SDL_DestroyWindow(window);
+        texture = nullptr;
+        renderer = nullptr;
+        window = nullptr;
+    }
     void SDL2Video::render() noexcept
+    {
+        if (presenting())
+        {
+            if (renderCallback) renderCallback();
+            fpsLimiter.FPSLimiter::wait();
+            return;
+        }
+
+        pollEvents();
+
+        if (renderCallback) renderCallback();
+
+        draw(frames.update());
+    }
+    void SDL2Video::pollEvents() noexcept
     {
         SDL_Event event{};
         while (SDL_PollEvent(&event))
@@ -353,30 +400,75 @@ namespace fcpp::io::detail
                 break;
             }
         }
+    }
+    void SDL2Video::draw(const bool upload) noexcept
+    {
+        if (upload)
+        {
+            auto frame = frames.front().data();
+            if (filter.getType() != VideoFilter::Type::None)
+            {
+                fcpp::util::Trace::Scope scope{ "video filter" };
+                frame = filter.process(frame);
+            }
+            fcpp::util::Trace::Scope scope{ "texture upload" };
+            if (SDL_UpdateTexture(texture, nullptr, frame, filter.getWidth() * static_cast<int>(sizeof(std::uint32_t))) != 0)
+                SDL_Log("SDL_UpdateTexture Error: %s\n", SDL_GetError());
+        }
 
-        if (renderCallback) renderCallback();
-
-        if (SDL_UpdateTexture(texture, nullptr, frameBuffer, 256 * sizeof(std::uint32_t)) != 0)
-            SDL_Log("SDL_UpdateTexture Error: %s\n", SDL_GetError());
-
+        fcpp::util::Trace::Scope scope{ "present" };
         if (SDL_RenderCopy(renderer, texture, nullptr, nullptr) != 0)
             SDL_Log("SDL_RenderCopy Error: %s\n", SDL_GetError());
+        if (!overlay.empty()) drawOverlay();
 
         SDL_RenderPresent(renderer);
     }
+    void SDL2Video::drawOverlay() noexcept
+    {   // a translucent panel with one bar per value, up to half of the window wide
+        static constexpr std::uint8_t colors[][3] = {
+            { 0x4c, 0xaf, 0x50 }, { 0x21, 0x96, 0xf3 }, { 0xff, 0x98, 0x00 }, { 0xe9, 0x1e, 0x63 }
+        };
+        int w = 0, h = 0;
+        SDL_GetRendererOutputSize(renderer, &w, &h);
+        int size = h / 64 > 2 ? h / 64 : 2, length = w / 2;
+
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_Rect rect{ 0, 0, length + 2 * size, (2 * static_cast<int>(overlay.size()) + 1) * size };
+        SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0x80);
+        SDL_RenderFillRect(renderer, &rect);
+        for (std::size_t i = 0; i < overlay.size(); i++)
+        {
+            auto value = overlay[i] < 0.0f ? 0.0f : (1.0f < overlay[i] ? 1.0f : overlay[i]);
+            auto& color = colors[i % (sizeof(colors) / sizeof(*colors))];
+            rect = { size, (2 * static_cast<int>(i) + 1) * size, static_cast<int>(value * length), size };
+            SDL_SetRenderDrawColor(renderer, color[0], color[1], color[2], 0xff);
+            SDL_RenderFillRect(renderer, &rect);
+        }
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    }
+    void SDL2Video::present() noexcept
+    {   // present the latest frame, waiting for vsync or a new frame keeps the loop from spinning
+        pollEvents();
+        auto fresh = frames.update();
+        if (fresh || vsync) draw(fresh);
+        else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
     bool SDL2Video::setFullScreen(const bool enable) noexcept
     {
+        if (post([this, enable]() { setFullScreen(enable); })) return true;
         windowMode = enable ? SDL_WINDOW_FULLSCREEN : 0;
         return window != nullptr ? (SDL_ShowCursor(enable ? SDL_DISABLE : SDL_ENABLE),
             SDL_SetWindowFullscreen(window, windowMode) == 0) : true;
     }
     bool SDL2Video::setBorderless(const bool enable) noexcept
     {
+        if (post([this, enable]() { setBorderless(enable); })) return true;
         windowMode = enable ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0;
         return window != nullptr ? SDL_SetWindowFullscreen(window, windowMode) == 0 : true;
     }
     bool SDL2Video::setVerticalSync(const bool enable) noexcept
     {
+        if (post([this, enable]() { setVerticalSync(enable); })) return true;
         if (vsync != enable)
         {
             vsync = enable;
@@ -393,7 +485,7 @@ namespace fcpp::io::detail
                     SDL_Log("SDL_CreateRenderer Error: %s\n", SDL_GetError());
                     return false;
                 }
-                texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 256, 240);
+                texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, filter.getWidth(), filter.getHeight());
                 if (texture == nullptr)
                 {
                     SDL_Log("SDL_CreateTexture Error: %s\n", SDL_GetError());
@@ -406,6 +498,7 @@ namespace fcpp::io::detail
     }
     bool SDL2Video::setRenderDriver(int idx) noexcept
     {
+        if (post([this, idx]() { setRenderDriver(idx); })) return true;
         renderDriverIdx = idx;
         if (renderer != nullptr && texture != nullptr)
         {
@@ -417,7 +510,7 @@ namespace fcpp::io::detail
                 SDL_Log("SDL_CreateRenderer Error: %s\n", SDL_GetError());
                 return false;
             }
-            texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, 256, 240);
+            texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, filter.getWidth(), filter.getHeight());
             if (texture == nullptr)
             {
                 SDL_Log("SDL_CreateTexture Error: %s\n", SDL_GetError());
@@ -428,6 +521,7 @@ namespace fcpp::io::detail
     }
     void SDL2Video::setScale(const double factor) noexcept
     {
+        if (post([this, factor]() { setScale(factor); })) return;
         width = static_cast<int>(256.0 * factor);
         height = static_cast<int>(240.0 * factor);
         if (window != nullptr)
@@ -436,32 +530,66 @@ namespace fcpp::io::detail
             SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
         }
     }
+    void SDL2Video::setVideoFilter(const VideoFilter::Type type, const int scale, const int threads)
+    {
+        if (post([this, type, scale, threads]() { setVideoFilter(type, scale, threads); })) return;
+        filter.set(type, scale, threads);
+        if (texture != nullptr)
+        {
+            SDL_DestroyTexture(texture);
+            texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, filter.getWidth(), filter.getHeight());
+            if (texture == nullptr) SDL_Log("SDL_CreateTexture Error: %s\n", SDL_GetError());
+        }
+    }
     void SDL2Video::setTitle(const char* const text) noexcept
     {
+        if (post([this, text = std::string{ text }]() { setTitle(text.c_str()); })) return;
         title = text;
         SDL_SetWindowTitle(window, text);
     }
+    void SDL2Video::setOverlay(std::vector<float> values) noexcept
+    {
+        if (post([this, values]() mutable { setOverlay(std::move(values)); })) return;
+        overlay = std::move(values);
+    }
     void SDL2Video::setFrameBufferData(const std::uint8_t* const data) noexcept
     {
-        if (data != nullptr) std::memcpy(frameBuffer, data, Controller::FrameBufferSize);
+        if (data == nullptr) return;
+        std::memcpy(frames.back().data(), data, Controller::FrameBufferSize);
+        frames.publish();
     }
     void SDL2Video::getFrameBufferData(std::uint8_t* const data) const noexcept
     {
-        if (data != nullptr) std::memcpy(data, frameBuffer, Controller::FrameBufferSize);
+        if (data != nullptr) std::memcpy(data, frames.last().data(), Controller::FrameBufferSize);
     }
     void SDL2Video::setPixel(const int x, const int y, const std::uint32_t color) noexcept
     {
-        frameBuffer[static_cast<std::size_t>(256) * y + x] = color;
+        frames.back()[static_cast<std::size_t>(256) * y + x] = color;
     }
     void SDL2Video::completedSignal() noexcept
-    {
+    {   // an unchanged frame is already the last published one
+        if (!unchangedFrame) frames.publish();
         if (frameCompletedCallback) frameCompletedCallback();
+        else if (presenting())
+        {
+            if (renderCallback) renderCallback();
+            fpsLimiter.wait();
+        }
         else
         {
             render();
             fpsLimiter.wait();
         }
     }
+    bool SDL2Video::keepsLastFrame() noexcept
+    {
+        frames.back() = frames.last();
+        return true;
+    }
+    void SDL2Video::setFrameUnchanged(const bool unchanged) noexcept
+    {
+        unchangedFrame = unchanged;
+    }
 
     class SDL2Input :
         public Input,
@@ -625,6 +753,7 @@ namespace fcpp::io::detail
 
         bool create() noexcept;
         void setVolume(double v) noexcept;
+        double getFillLevel() const noexcept;
     private:
         void sendSample(double sample) noexcept override;
     private:
@@ -677,6 +806,10 @@ namespace fcpp::io::detail
     {
         volume = v < 0.0 ? 0.0 : (100.0f < v ? 1.0 : v / 100.0);
     }
+    double SDL2Audio::getFillLevel() const noexcept
+    {
+        return static_cast<double>(frames * buffSize + count) / (buffSize * buffNum);
+    }
     void SDL2Audio::sendSample(const double sample) noexcept
     {
         if (frames < buffNum)
@@ -692,13 +825,19 @@ namespace fcpp::io::detail
     }
     void SDL2Audio::fillBuffer(std::uint8_t* const buffer, const int len) noexcept
     {
+        fcpp::util::Trace::setThreadName("audio");
+        fcpp::util::Trace::Scope scope{ "audio fill" };
         if (frames)
         {
             SDL_memcpy(buffer, samples + readIdx * buffSize, len);
             ++readIdx;
             --frames;
         }
-        else SDL_memset(buffer, 0, len);
+        else
+        {
+            fcpp::util::Trace::instant("audio underrun");
+            SDL_memset(buffer, 0, len);
+        }
     }
     void SDL2Audio::callback(void* const data, std::uint8_t* const buffer, const int len) noexcept
     {
@@ -737,6 +876,10 @@ void fcpp::io::SDL2Controller::render() noexcept
 {
     dptr->video.render();
 }
+void fcpp::io::SDL2Controller::setPresentThread(const bool enable) noexcept
+{
+    dptr->video.setPresentThread(enable);
+}
 bool fcpp::io::SDL2Controller::setFullScreen(const bool enable) noexcept
 {
     return dptr->video.setFullScreen(enable);
@@ -761,6 +904,10 @@ void fcpp::io::SDL2Controller::setScale(const float factor) noexcept
 {
     dptr->video.setScale(factor);
 }
+void fcpp::io::SDL2Controller::setVideoFilter(const VideoFilter::Type type, const int scale, const int threads)
+{
+    dptr->video.setVideoFilter(type, scale, threads);
+}
 void fcpp::io::SDL2Controller::setTitle(const char* const text) noexcept
 {
     dptr->video.setTitle(text);
@@ -769,6 +916,19 @@ void fcpp::io::SDL2Controller::setFPSLimit(const double fps) noexcept
 {
     dptr->video.setFPSLimit(fps);
 }
+void fcpp::io::SDL2Controller::setAudioSync(const bool enable) noexcept
+{
+    if (enable) dptr->video.setAudioClock([this]() { return dptr->audio.getFillLevel(); });
+    else dptr->video.setAudioClock(nullptr);
+}
+fcpp::io::Controller::PacingStats fcpp::io::SDL2Controller::getPacingStats() noexcept
+{
+    return dptr->video.getPacingStats();
+}
+void fcpp::io::SDL2Controller::setOverlay(const float* const values, const int count) noexcept
+{
+    dptr->video.setOverlay(std::vector<float>(values, values + (values != nullptr && count > 0 ? count : 0)));
+}
 void fcpp::io::SDL2Controller::setVolume(const float volume) noexcept
 {
     dptr->audio.setVolume(volume);
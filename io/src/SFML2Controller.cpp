@@ -1,5 +1,8 @@
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstring>
+#include <string>
 #include <utility>
 
 #include <SFML/Window.hpp>
@@ -229,7 +232,7 @@ namespace fcpp::io::detail
     {
     public:
         SFML2Video() = default;
-        ~SFML2Video() override = default;
+        ~SFML2Video() noexcept override;
 
         bool create() noexcept;
         void render() noexcept;
@@ -237,12 +240,22 @@ namespace fcpp::io::detail
         bool setBorderless(bool enable) noexcept;
         bool setVerticalSync(bool enable) noexcept;
         void setScale(float factor) noexcept;
+        void setVideoFilter(VideoFilter::Type type, int scale, int threads);
         void setTitle(const char* text) noexcept;
         void setFrameBufferData(const std::uint8_t* data) noexcept;
         void getFrameBufferData(std::uint8_t* data) const noexcept;
     private:
         void setPixel(int x, int y, std::uint32_t color) noexcept override;
         void completedSignal() noexcept override;
+        bool keepsLastFrame() noexcept override;
+        void setFrameUnchanged(bool unchanged) noexcept override;
+    private:
+        bool createWindow() noexcept;
+        void pollEvents() noexcept;
+        void draw(bool upload) noexcept;
+        void present() noexcept;
+        // the sprite is drawn over the 256x240 view whatever the filter output size is
+        bool createTexture() noexcept;
     private:
         bool vsync = false;
         unsigned int width = 256, height = 240;
@@ -251,21 +264,52 @@ namespace fcpp::io::detail
         sf::String title{ "FCPP SFML2 Renderer" };
         sf::VideoMode videoMode{ width, height };
         sf::RenderWindow window{};
-        sf::Image image{};
         sf::Texture texture{};
         sf::Sprite sprite{};
+        bool unchangedFrame = false;
+        VideoFilter filter{ VideoFilter::PixelFormat::RGBA };
+        fcpp::util::TripleBuffer<std::array<std::uint8_t, Controller::FrameBufferSize>> frames{};
     };
+    SFML2Video::~SFML2Video() noexcept
+    {
+        stopPresentThread();
+    }
     bool SFML2Video::create() noexcept
+    {
+        if (presentThreadFlag)
+            return startPresentThread([this]() { return createWindow(); }, [this]() { present(); }, [this]() { window.close(); });
+        return createWindow();
+    }
+    bool SFML2Video::createWindow() noexcept
     {
         window.create(videoMode, title, style);
         window.setVerticalSyncEnabled(vsync);
         window.setView(sf::View{ sf::FloatRect(0.0f, 0.0f, 256.0f, 240.0f) });
-        image.create(256, 240);
-        if (!texture.create(256, 240)) return false;
-        sprite.setTexture(texture);
+        return createTexture();
+    }
+    bool SFML2Video::createTexture() noexcept
+    {
+        if (!texture.create(filter.getWidth(), filter.getHeight())) return false;
+        sprite.setTexture(texture, true);
+        sprite.setScale(256.0f / filter.getWidth(), 240.0f / filter.getHeight());
         return true;
     }
     void SFML2Video::render() noexcept
+    {
+        if (presenting())
+        {
+            if (renderCallback) renderCallback();
+            fpsLimiter.FPSLimiter::wait();
+            return;
+        }
+
+        pollEvents();
+
+        if (renderCallback) renderCallback();
+
+        draw(frames.update());
+    }
+    void SFML2Video::pollEvents() noexcept
     {
         sf::Event event{};
         while (window.pollEvent(event))
@@ -293,15 +337,32 @@ namespace fcpp::io::detail
                 break;
             }
         }
-
-        if (renderCallback) renderCallback();
-
-        texture.update(image);
+    }
+    void SFML2Video::draw(const bool upload) noexcept
+    {
+        if (upload)
+        {
+            auto frame = reinterpret_cast<const std::uint32_t*>(frames.front().data());
+            if (filter.getType() != VideoFilter::Type::None)
+            {
+                fcpp::util::Trace::Scope scope{ "video filter" };
+                frame = filter.process(frame);
+            }
+            texture.update(reinterpret_cast<const sf::Uint8*>(frame));
+        }
         window.draw(sprite);
         window.display();
     }
+    void SFML2Video::present() noexcept
+    {   // present the latest frame, waiting for vsync or a new frame keeps the loop from spinning
+        pollEvents();
+        auto fresh = frames.update();
+        if (fresh || vsync) draw(fresh);
+        else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
     bool SFML2Video::setFullScreen(const bool enable) noexcept
     {
+        if (post([this, enable]() { setFullScreen(enable); })) return true;
         videoMode = enable ? sf::VideoMode::getDesktopMode() : sf::VideoMode(width, height);
         style = enable ? sf::Style::Fullscreen : sf::Style::Default;
         if (window.isOpen())
@@ -314,6 +375,7 @@ namespace fcpp::io::detail
     }
     bool SFML2Video::setBorderless(const bool enable) noexcept
     {
+        if (post([this, enable]() { setBorderless(enable); })) return true;
         videoMode = enable ? sf::VideoMode::getDesktopMode() : sf::VideoMode(width, height);
         style = enable ? sf::Style::None : sf::Style::Default;
         if (window.isOpen())
@@ -326,41 +388,71 @@ namespace fcpp::io::detail
     }
     bool SFML2Video::setVerticalSync(const bool enable) noexcept
     {
+        if (post([this, enable]() { setVerticalSync(enable); })) return true;
         if (vsync != enable) window.setVerticalSyncEnabled(vsync = enable);
         return true;
     }
     void SFML2Video::setScale(const float factor) noexcept
     {
+        if (post([this, factor]() { setScale(factor); })) return;
         width = static_cast<unsigned int>(256.0 * factor);
         height = static_cast<unsigned int>(240.0 * factor);
         videoMode = sf::VideoMode(width, height);
         if (window.isOpen()) window.setSize(sf::Vector2u(width, height));
     }
+    void SFML2Video::setVideoFilter(const VideoFilter::Type type, const int scale, const int threads)
+    {
+        if (post([this, type, scale, threads]() { setVideoFilter(type, scale, threads); })) return;
+        filter.set(type, scale, threads);
+        if (window.isOpen()) createTexture();
+    }
     void SFML2Video::setTitle(const char* const text) noexcept
     {
+        if (post([this, text = std::string{ text }]() { setTitle(text.c_str()); })) return;
         window.setTitle(title = text);
     }
     void SFML2Video::setFrameBufferData(const std::uint8_t* const data) noexcept
     {
-        if (data != nullptr) std::memcpy(const_cast<std::uint8_t*>(image.getPixelsPtr()), data, Controller::FrameBufferSize);
+        if (data == nullptr) return;
+        std::memcpy(frames.back().data(), data, Controller::FrameBufferSize);
+        frames.publish();
     }
     void SFML2Video::getFrameBufferData(std::uint8_t* const data) const noexcept
     {
-        if (data != nullptr) std::memcpy(data, image.getPixelsPtr(), Controller::FrameBufferSize);
+        if (data != nullptr) std::memcpy(data, frames.last().data(), Controller::FrameBufferSize);
     }
     void SFML2Video::setPixel(const int x, const int y, const std::uint32_t color) noexcept
-    {
-        image.setPixel(x, y, sf::Color((color << 8) | 0xff));
+    {   // RGBA
+        auto pixel = frames.back().data() + (static_cast<std::size_t>(256) * y + x) * 4;
+        pixel[0] = (color >> 16) & 0xff;
+        pixel[1] = (color >> 8) & 0xff;
+        pixel[2] = color & 0xff;
+        pixel[3] = 0xff;
     }
     void SFML2Video::completedSignal() noexcept
-    {
+    {   // an unchanged frame is already the last published one
+        if (!unchangedFrame) frames.publish();
         if (frameCompletedCallback) frameCompletedCallback();
+        else if (presenting())
+        {
+            if (renderCallback) renderCallback();
+            fpsLimiter.wait();
+        }
         else
         {
             render();
             fpsLimiter.wait();
         }
     }
+    bool SFML2Video::keepsLastFrame() noexcept
+    {
+        frames.back() = frames.last();
+        return true;
+    }
+    void SFML2Video::setFrameUnchanged(const bool unchanged) noexcept
+    {
+        unchangedFrame = unchanged;
+    }
 
     class SFML2Input : public Input
     {
@@ -494,6 +586,7 @@ namespace fcpp::io::detail
 
         void create() noexcept;
         void setVolume(float v) noexcept;
+        double getFillLevel() const noexcept;
     private:
         void sendSample(double sample) noexcept override;
     private:
@@ -517,6 +610,10 @@ namespace fcpp::io::detail
     {
         sf::SoundStream::setVolume(v);
     }
+    double SFML2Audio::getFillLevel() const noexcept
+    {
+        return static_cast<double>(frames * buffSize + count) / (buffSize * buffNum);
+    }
     void SFML2Audio::sendSample(const double sample) noexcept
     {
         if (frames < buffNum)
@@ -585,6 +682,10 @@ void fcpp::io::SFML2Controller::render() noexcept
 {
     dptr->video.render();
 }
+void fcpp::io::SFML2Controller::setPresentThread(const bool enable) noexcept
+{
+    dptr->video.setPresentThread(enable);
+}
 bool fcpp::io::SFML2Controller::setFullScreen(const bool enable) noexcept
 {
     return dptr->video.setFullScreen(enable);
@@ -609,6 +710,10 @@ void fcpp::io::SFML2Controller::setScale(const float factor) noexcept
 {
     dptr->video.setScale(factor);
 }
+void fcpp::io::SFML2Controller::setVideoFilter(const VideoFilter::Type type, const int scale, const int threads)
+{
+    dptr->video.setVideoFilter(type, scale, threads);
+}
 void fcpp::io::SFML2Controller::setTitle(const char* const text) noexcept
 {
     dptr->video.setTitle(text);
@@ -617,6 +722,16 @@ void fcpp::io::SFML2Controller::setFPSLimit(const double fps) noexcept
 {
     dptr->video.setFPSLimit(fps);
 }
+void fcpp::io::SFML2Controller::setAudioSync(const bool enable) noexcept
+{
+    if (enable) dptr->video.setAudioClock([this]() { return dptr->audio.getFillLevel(); });
+    else dptr->video.setAudioClock(nullptr);
+}
+fcpp::io::Controller::PacingStats fcpp::io::SFML2Controller::getPacingStats() noexcept
+{
+    return dptr->video.getPacingStats();
+}
+void fcpp::io::SFML2Controller::setOverlay(const float* /* values */, int /* count */) noexcept {}
 void fcpp::io::SFML2Controller::setVolume(const float volume) noexcept
 {
     dptr->audio.setVolume(volume);
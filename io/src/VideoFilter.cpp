@@ -0,0 +1,425 @@
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define FCPP_IO_VIDEO_FILTER_SSE2
+#   include <emmintrin.h>
+#endif
+
+#include "FCPP/IO/VideoFilter.hpp"
+
+namespace fcpp::io::detail
+{
+    static constexpr int FrameWidth = 256, FrameHeight = 240;
+
+    // runs a task over bands of rows, the calling thread takes the first band and waits for the others
+    class BandPool
+    {
+    public:
+        BandPool() = default;
+        ~BandPool() noexcept;
+
+        void resize(int threads);
+        void run(int rows, const std::function<void(int, int)>& task);
+    private:
+        void stop() noexcept;
+        void work(int idx, unsigned seen);
+    private:
+        std::mutex mutex{};
+        std::condition_variable start{};
+        std::condition_variable done{};
+        const std::function<void(int, int)>* current = nullptr;
+        int count = 0;
+        int pending = 0;
+        unsigned generation = 0;
+        bool quit = false;
+        std::vector<std::thread> workers{};
+    };
+    BandPool::~BandPool() noexcept
+    {
+        stop();
+    }
+    void BandPool::resize(const int threads)
+    {
+        if (threads == static_cast<int>(workers.size()) + 1) return;
+        stop();
+        quit = false;
+        for (int i = 1; i < threads; i++) workers.emplace_back(&BandPool::work, this, i, generation);
+    }
+    void BandPool::run(const int rows, const std::function<void(int, int)>& task)
+    {
+        if (workers.empty()) return task(0, rows);
+
+        auto threads = static_cast<int>(workers.size()) + 1;
+        {
+            std::lock_guard lock{ mutex };
+            current = &task;
+            count = rows;
+            pending = threads - 1;
+            generation++;
+        }
+        start.notify_all();
+        task(0, rows / threads);
+
+        std::unique_lock lock{ mutex };
+        done.wait(lock, [&]() { return !pending; });
+    }
+    void BandPool::stop() noexcept
+    {
+        {
+            std::lock_guard lock{ mutex };
+            quit = true;
+        }
+        start.notify_all();
+        for (auto&& worker : workers) worker.join();
+        workers.clear();
+    }
+    void BandPool::work(const int idx, unsigned seen)
+    {
+        std::unique_lock lock{ mutex };
+        for (;;)
+        {
+            start.wait(lock, [&]() { return quit || seen != generation; });
+            if (quit) return;
+            seen = generation;
+
+            auto threads = static_cast<int>(workers.size()) + 1;
+            auto& task = *current;
+            int begin = count * idx / threads, end = count * (idx + 1) / threads;
+            lock.unlock();
+            task(begin, end);
+            lock.lock();
+            if (!--pending) done.notify_one();
+        }
+    }
+
+    // each pixel repeated scale times
+    template<int scale>
+    static void repeatRow(const std::uint32_t* const src, std::uint32_t* const dst, const int width) noexcept
+    {
+#ifdef FCPP_IO_VIDEO_FILTER_SSE2
+        for (int x = 0; x < width; x += 4)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+            auto out = reinterpret_cast<__m128i*>(dst + x * scale);
+            if constexpr (scale == 2)
+            {
+                _mm_storeu_si128(out, _mm_unpacklo_epi32(v, v));
+                _mm_storeu_si128(out + 1, _mm_unpackhi_epi32(v, v));
+            }
+            else if constexpr (scale == 3)
+            {
+                _mm_storeu_si128(out, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 0, 0)));
+                _mm_storeu_si128(out + 1, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 1, 1)));
+                _mm_storeu_si128(out + 2, _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 2)));
+            }
+            else
+            {
+                _mm_storeu_si128(out, _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 0, 0, 0)));
+                _mm_storeu_si128(out + 1, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 1, 1, 1)));
+                _mm_storeu_si128(out + 2, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 2, 2)));
+                _mm_storeu_si128(out + 3, _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+        }
+#else
+        for (int x = 0; x < width; x++)
+            for (int i = 0; i < scale; i++) dst[x * scale + i] = src[x];
+#endif
+    }
+    static void nearest(const std::uint32_t* const src, std::uint32_t* const dst, const int scale, const int begin, const int end) noexcept
+    {
+        auto width = static_cast<std::size_t>(FrameWidth) * scale;
+        for (int y = begin; y < end; y++)
+        {
+            auto row = dst + width * scale * y;
+            switch (scale)
+            {
+            case 2:
+                repeatRow<2>(src + FrameWidth * y, row, FrameWidth);
+                break;
+            case 3:
+                repeatRow<3>(src + FrameWidth * y, row, FrameWidth);
+                break;
+            case 4:
+                repeatRow<4>(src + FrameWidth * y, row, FrameWidth);
+                break;
+            default:
+                std::memcpy(row, src + FrameWidth * y, width * sizeof(std::uint32_t));
+                break;
+            }
+            for (int i = 1; i < scale; i++) std::memcpy(row + width * i, row, width * sizeof(std::uint32_t));
+        }
+    }
+
+    // EPX: a corner takes the color of its two neighbors when they match and the other two sides differ
+    static void scale2x(const std::uint32_t* const src, std::uint32_t* const dst, const int width, const int height, const int begin, const int end) noexcept
+    {
+        std::uint32_t line[2 * FrameWidth + 2]{};
+        for (int y = begin; y < end; y++)
+        {
+            auto above = src + static_cast<std::size_t>(width) * (y > 0 ? y - 1 : y);
+            auto below = src + static_cast<std::size_t>(width) * (y < height - 1 ? y + 1 : y);
+            auto top = dst + static_cast<std::size_t>(width) * 4 * y, bottom = top + static_cast<std::size_t>(width) * 2;
+            // the row with its edge pixels repeated, so the left and right neighbors are plain loads
+            std::memcpy(line + 1, src + static_cast<std::size_t>(width) * y, width * sizeof(std::uint32_t));
+            line[0] = line[1];
+            line[width + 1] = line[width];
+#ifdef FCPP_IO_VIDEO_FILTER_SSE2
+            for (int x = 0; x < width; x += 4)
+            {
+                auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(above + x));
+                auto h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(below + x));
+                auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + x));
+                auto e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + x + 1));
+                auto f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + x + 2));
+                auto db = _mm_cmpeq_epi32(d, b), bf = _mm_cmpeq_epi32(b, f), dh = _mm_cmpeq_epi32(d, h), hf = _mm_cmpeq_epi32(h, f);
+                auto c0 = _mm_andnot_si128(_mm_or_si128(bf, dh), db);
+                auto c1 = _mm_andnot_si128(_mm_or_si128(db, hf), bf);
+                auto c2 = _mm_andnot_si128(_mm_or_si128(db, hf), dh);
+                auto c3 = _mm_andnot_si128(_mm_or_si128(dh, bf), hf);
+                auto e0 = _mm_or_si128(_mm_and_si128(c0, d), _mm_andnot_si128(c0, e));
+                auto e1 = _mm_or_si128(_mm_and_si128(c1, f), _mm_andnot_si128(c1, e));
+                auto e2 = _mm_or_si128(_mm_and_si128(c2, d), _mm_andnot_si128(c2, e));
+                auto e3 = _mm_or_si128(_mm_and_si128(c3, f), _mm_andnot_si128(c3, e));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(top + 2 * x), _mm_unpacklo_epi32(e0, e1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(top + 2 * x + 4), _mm_unpackhi_epi32(e0, e1));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(bottom + 2 * x), _mm_unpacklo_epi32(e2, e3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(bottom + 2 * x + 4), _mm_unpackhi_epi32(e2, e3));
+            }
+#else
+            for (int x = 0; x < width; x++)
+            {
+                auto b = above[x], h = below[x], d = line[x], e = line[x + 1], f = line[x + 2];
+                top[2 * x] = d == b && b != f && d != h ? d : e;
+                top[2 * x + 1] = b == f && b != d && f != h ? f : e;
+                bottom[2 * x] = d == h && d != b && h != f ? d : e;
+                bottom[2 * x + 1] = h == f && d != h && b != f ? f : e;
+            }
+#endif
+        }
+    }
+
+    /*
+    * A NTSC pixel lasts 4 master clocks and the color carrier 6, so the carrier phase repeats every 3 pixels,
+    * each line starts 2 clocks later and every other frame is one pixel shorter, giving 3 line phases.
+    * The line is sampled scale times per pixel as Y + I cos + Q sin, luma is averaged over one carrier period,
+    * chroma is demodulated over two periods, both with box filters from running sums.
+    */
+    class NTSC
+    {
+    public:
+        NTSC() = default;
+        ~NTSC() = default;
+
+        void set(int scale, int rShift, int bShift);
+        void line(const std::uint32_t* src, std::uint32_t* dst, int phase) const noexcept;
+    public:
+        // pixels outside of the line repeat the edge ones
+        static constexpr int Padding = 2;
+    private:
+        int scale = 2;
+        int rShift = 16, bShift = 0;
+        int lumaWindow = 3, chromaWindow = 6;
+        // per line phase and padded sample
+        std::vector<float> carrier[3][2]{};
+    };
+    void NTSC::set(const int s, const int r, const int b)
+    {
+        static const double pi = std::acos(-1.0);
+        scale = s;
+        rShift = r;
+        bShift = b;
+        lumaWindow = 3 * scale / 2;
+        chromaWindow = 3 * scale;
+        auto samples = (FrameWidth + 2 * Padding) * scale;
+        for (int phase = 0; phase < 3; phase++)
+        {
+            carrier[phase][0].resize(samples);
+            carrier[phase][1].resize(samples);
+            for (int i = 0; i < samples; i++)
+            {   // in master clocks
+                auto clock = 4.0 * (i - Padding * scale) / scale + 2.0 * phase;
+                carrier[phase][0][i] = static_cast<float>(std::cos(2.0 * pi * clock / 6.0));
+                carrier[phase][1][i] = static_cast<float>(std::sin(2.0 * pi * clock / 6.0));
+            }
+        }
+    }
+    void NTSC::line(const std::uint32_t* const src, std::uint32_t* const dst, const int phase) const noexcept
+    {
+        static constexpr int MaxSamples = (FrameWidth + 2 * Padding) * 4 + 1;
+        float sumY[MaxSamples], sumI[MaxSamples], sumQ[MaxSamples];
+        auto cosine = carrier[phase][0].data(), sine = carrier[phase][1].data();
+
+        // encode, the running sums are the serial part
+        float y = 0.0f, i = 0.0f, q = 0.0f;
+        sumY[0] = sumI[0] = sumQ[0] = 0.0f;
+        for (int x = -Padding, j = 0; x < FrameWidth + Padding; x++)
+        {
+            auto color = src[x < 0 ? 0 : (x < FrameWidth ? x : FrameWidth - 1)];
+            auto r = static_cast<float>((color >> rShift) & 0xff), g = static_cast<float>((color >> 8) & 0xff), b = static_cast<float>((color >> bShift) & 0xff);
+            auto luma = 0.299f * r + 0.587f * g + 0.114f * b;
+            auto inPhase = 0.596f * r - 0.274f * g - 0.322f * b;
+            auto quadrature = 0.211f * r - 0.523f * g + 0.312f * b;
+            for (int k = 0; k < scale; k++, j++)
+            {
+                auto signal = luma + inPhase * cosine[j] + quadrature * sine[j];
+                y += signal;
+                i += signal * cosine[j];
+                q += signal * sine[j];
+                sumY[j + 1] = y;
+                sumI[j + 1] = i;
+                sumQ[j + 1] = q;
+            }
+        }
+
+        // decode, independent per sample
+        auto center = Padding * scale;
+        auto lumaBegin = center - lumaWindow / 2, lumaEnd = lumaBegin + lumaWindow;
+        auto chromaBegin = center - chromaWindow / 2, chromaEnd = chromaBegin + chromaWindow;
+        auto lumaGain = 1.0f / lumaWindow, chromaGain = 2.0f / chromaWindow;
+        auto width = FrameWidth * scale;
+#ifdef FCPP_IO_VIDEO_FILTER_SSE2
+        auto lumaFactor = _mm_set1_ps(lumaGain), chromaFactor = _mm_set1_ps(chromaGain);
+        auto zero = _mm_setzero_ps(), max = _mm_set1_ps(255.0f);
+        auto alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+        auto rCount = _mm_cvtsi32_si128(rShift), bCount = _mm_cvtsi32_si128(bShift);
+        for (int j = 0; j < width; j += 4)
+        {
+            auto luma = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(sumY + j + lumaEnd), _mm_loadu_ps(sumY + j + lumaBegin)), lumaFactor);
+            auto inPhase = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(sumI + j + chromaEnd), _mm_loadu_ps(sumI + j + chromaBegin)), chromaFactor);
+            auto quadrature = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(sumQ + j + chromaEnd), _mm_loadu_ps(sumQ + j + chromaBegin)), chromaFactor);
+            auto r = _mm_add_ps(luma, _mm_add_ps(_mm_mul_ps(inPhase, _mm_set1_ps(0.956f)), _mm_mul_ps(quadrature, _mm_set1_ps(0.621f))));
+            auto g = _mm_sub_ps(luma, _mm_add_ps(_mm_mul_ps(inPhase, _mm_set1_ps(0.272f)), _mm_mul_ps(quadrature, _mm_set1_ps(0.647f))));
+            auto b = _mm_add_ps(luma, _mm_sub_ps(_mm_mul_ps(quadrature, _mm_set1_ps(1.703f)), _mm_mul_ps(inPhase, _mm_set1_ps(1.106f))));
+            auto ri = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(r, zero), max));
+            auto gi = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(g, zero), max));
+            auto bi = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(b, zero), max));
+            auto pixels = _mm_or_si128(_mm_or_si128(alpha, _mm_slli_epi32(gi, 8)), _mm_or_si128(_mm_sll_epi32(ri, rCount), _mm_sll_epi32(bi, bCount)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j), pixels);
+        }
+#else
+        // the same order of operations and round to nearest even as the SSE2 path, so both give the same pixels
+        auto clamp = [](const float v) { return static_cast<std::uint32_t>(std::lrintf(v < 0.0f ? 0.0f : (255.0f < v ? 255.0f : v))); };
+        for (int j = 0; j < width; j++)
+        {
+            auto luma = (sumY[j + lumaEnd] - sumY[j + lumaBegin]) * lumaGain;
+            auto inPhase = (sumI[j + chromaEnd] - sumI[j + chromaBegin]) * chromaGain;
+            auto quadrature = (sumQ[j + chromaEnd] - sumQ[j + chromaBegin]) * chromaGain;
+            auto r = clamp(luma + (inPhase * 0.956f + quadrature * 0.621f));
+            auto g = clamp(luma - (inPhase * 0.272f + quadrature * 0.647f));
+            auto b = clamp(luma + (quadrature * 1.703f - inPhase * 1.106f));
+            dst[j] = 0xff000000 | r << rShift | g << 8 | b << bShift;
+        }
+#endif
+    }
+}
+
+struct fcpp::io::VideoFilter::VideoFilterData
+{
+    Type type = Type::None;
+    PixelFormat format = PixelFormat::ARGB;
+    int scale = 1;
+    std::uint32_t frame = 0;
+    detail::NTSC ntsc{};
+    detail::BandPool pool{};
+    // the 2x frame between the two Scale2x passes of 4x
+    std::vector<std::uint32_t> middle{};
+    std::vector<std::uint32_t> output{};
+};
+
+fcpp::io::VideoFilter::VideoFilter(const PixelFormat format) : dptr(std::make_unique<VideoFilterData>())
+{
+    dptr->format = format;
+}
+fcpp::io::VideoFilter::~VideoFilter() noexcept = default;
+
+void fcpp::io::VideoFilter::set(const Type type, const int scale, const int threads)
+{
+    dptr->type = type;
+    switch (type)
+    {
+    case Type::Nearest:
+        dptr->scale = scale < 1 ? 1 : (4 < scale ? 4 : scale);
+        break;
+    case Type::Scale2x:
+    case Type::NTSC:
+        dptr->scale = scale < 4 ? 2 : 4;
+        break;
+    default:
+        dptr->scale = 1;
+        break;
+    }
+
+    dptr->middle.resize(type == Type::Scale2x && dptr->scale == 4 ? static_cast<std::size_t>(detail::FrameWidth) * detail::FrameHeight * 4 : 0);
+    dptr->output.resize(type != Type::None ? static_cast<std::size_t>(getWidth()) * getHeight() : 0);
+    if (type == Type::NTSC)
+    {
+        if (dptr->format == PixelFormat::RGBA) dptr->ntsc.set(dptr->scale, 0, 16);
+        else dptr->ntsc.set(dptr->scale, 16, 0);
+    }
+
+    auto count = threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency());
+    dptr->pool.resize(count < 1 ? 1 : (16 < count ? 16 : count));
+}
+fcpp::io::VideoFilter::Type fcpp::io::VideoFilter::getType() const noexcept
+{
+    return dptr->type;
+}
+int fcpp::io::VideoFilter::getWidth() const noexcept
+{
+    return detail::FrameWidth * dptr->scale;
+}
+int fcpp::io::VideoFilter::getHeight() const noexcept
+{
+    return detail::FrameHeight * dptr->scale;
+}
+const std::uint32_t* fcpp::io::VideoFilter::process(const std::uint32_t* const frame) noexcept
+{
+    auto scale = dptr->scale;
+    auto output = dptr->output.data();
+    switch (dptr->type)
+    {
+    case Type::Nearest:
+        dptr->pool.run(detail::FrameHeight, [&](const int begin, const int end) {
+            detail::nearest(frame, output, scale, begin, end);
+        });
+        break;
+    case Type::Scale2x:
+        if (scale == 4)
+        {
+            auto middle = dptr->middle.data();
+            dptr->pool.run(detail::FrameHeight, [&](const int begin, const int end) {
+                detail::scale2x(frame, middle, detail::FrameWidth, detail::FrameHeight, begin, end);
+            });
+            dptr->pool.run(detail::FrameHeight * 2, [&](const int begin, const int end) {
+                detail::scale2x(middle, output, detail::FrameWidth * 2, detail::FrameHeight * 2, begin, end);
+            });
+        }
+        else dptr->pool.run(detail::FrameHeight, [&](const int begin, const int end) {
+            detail::scale2x(frame, output, detail::FrameWidth, detail::FrameHeight, begin, end);
+        });
+        break;
+    case Type::NTSC:
+    {
+        auto shift = dptr->frame++ & 1;
+        auto width = static_cast<std::size_t>(detail::FrameWidth) * scale;
+        dptr->pool.run(detail::FrameHeight, [&](const int begin, const int end) {
+            for (int y = begin; y < end; y++)
+            {
+                auto row = output + width * scale * y;
+                dptr->ntsc.line(frame + detail::FrameWidth * y, row, static_cast<int>((y + shift) % 3));
+                for (int i = 1; i < scale; i++) std::memcpy(row + width * i, row, width * sizeof(std::uint32_t));
+            }
+        });
+        break;
+    }
+    default:
+        return frame;
+    }
+    return output;
+}
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "FCPP/Core/FC.hpp"
+
+namespace
+{
+    // the whole address space as plain memory, while a trace is set accesses are recorded and writes are dropped
+    struct Memory
+    {
+        std::uint8_t data[0x10000]{};
+        std::vector<std::uint32_t>* trace = nullptr;
+        std::uint64_t cycles = 0;
+    } memory{};
+}
+
+// the CPU runs alone, on stand-ins for the bus and the clock of a machine
+struct fcpp::core::Bus::BusData {};
+struct fcpp::core::Clock::ClockData {};
+
+fcpp::core::Bus::Bus() : dptr(std::make_unique<BusData>()) {}
+fcpp::core::Bus::~Bus() noexcept = default;
+template<> std::uint8_t fcpp::core::Bus::read<fcpp::core::CPU>(const std::uint16_t addr) noexcept
+{
+    if (memory.trace != nullptr) memory.trace->push_back(addr);
+    return memory.data[addr];
+}
+template<> void fcpp::core::Bus::write<fcpp::core::CPU>(const std::uint16_t addr, const std::uint8_t data) noexcept
+{
+    if (memory.trace != nullptr) memory.trace->push_back(1 << 24 | data << 16 | addr);
+    else memory.data[addr] = data;
+}
+bool fcpp::core::Bus::copyOAM(std::uint16_t /* src */, unsigned int /* cycles */) noexcept
+{
+    return false;
+}
+
+fcpp::core::Clock::Clock() : dptr(std::make_unique<ClockData>()) {}
+fcpp::core::Clock::~Clock() noexcept = default;
+void fcpp::core::Clock::tick() noexcept
+{
+    memory.cycles++;
+}
+void fcpp::core::Clock::tick(const std::uint32_t cycles) noexcept
+{
+    memory.cycles += cycles;
+}
+std::uint64_t fcpp::core::Clock::getCPUCycles() noexcept
+{
+    return memory.cycles;
+}
+
+// the public CPU of CPU.cpp is built along with it, but it is never connected to a machine
+fcpp::core::Bus* fcpp::core::FC::getBus() noexcept
+{
+    std::abort();
+}
+fcpp::core::Clock* fcpp::core::FC::getClock() noexcept
+{
+    std::abort();
+}
+fcpp::core::Profiler* fcpp::core::FC::getProfiler() noexcept
+{
+    std::abort();
+}
+fcpp::core::Snapshot::Writer& fcpp::core::Snapshot::getWriter() const noexcept
+{
+    std::abort();
+}
+fcpp::core::Snapshot::Reader& fcpp::core::Snapshot::getReader() const noexcept
+{
+    std::abort();
+}
+
+// both CPUs come after the bus they read and write through has been specialized
+#include "ReferenceCPU.hpp"
+#include CPU_SOURCE_PATH
+
+#undef T
+#undef I
+
+// pc, then a, x, y, sp, p and the internal state in the order CPUImpl::access visits them
+struct State
+{
+    std::uint16_t pc = 0;
+    std::uint8_t regs[6]{};
+
+    bool operator==(const State& other) const noexcept
+    {
+        return pc == other.pc && std::memcmp(regs, other.regs, sizeof(regs)) == 0;
+    }
+};
+
+struct Setter
+{
+    const State& state;
+    int idx = 0;
+
+    template<typename Register>
+    void access(Register& r) noexcept
+    {
+        if constexpr (std::is_same_v<Register, std::uint16_t>) r = state.pc;
+        else r = state.regs[idx++];
+    }
+};
+
+struct Getter
+{
+    State state{};
+    int idx = 0;
+
+    template<typename Register>
+    void access(Register& r) noexcept
+    {
+        if constexpr (std::is_same_v<Register, std::uint16_t>) state.pc = r;
+        else state.regs[idx++] = static_cast<std::uint8_t>(r);
+    }
+};
+
+template<typename Impl>
+struct Runner
+{
+    Impl cpu{};
+    State result{};
+    std::vector<std::uint32_t> trace{};
+
+    Runner(fcpp::core::Bus* const bus, fcpp::core::Clock* const clock, fcpp::core::Profiler* const profiler)
+    {
+        cpu.connect(bus, clock, profiler);
+        trace.reserve(64);
+    }
+    // run count instructions from state, the bus traffic and the cycles end up in trace
+    void run(const State& state, const int count) noexcept
+    {
+        Setter setter{ state };
+        cpu.access(setter);
+        trace.clear();
+        memory.trace = &trace;
+        memory.cycles = 0;
+        for (int k = 0; k < count; k++) cpu.exec();
+        memory.trace = nullptr;
+        trace.push_back(static_cast<std::uint32_t>(memory.cycles));
+        Getter getter{};
+        cpu.access(getter);
+        result = getter.state;
+    }
+    // seconds to run count instructions from $8000
+    double bench(const long count) noexcept
+    {
+        State state{};
+        state.pc = 0x8000;
+        Setter setter{ state };
+        cpu.access(setter);
+        auto begin = std::chrono::steady_clock::now();
+        for (long k = 0; k < count; k++) cpu.exec();
+        std::chrono::duration<double> time = std::chrono::steady_clock::now() - begin;
+        return time.count();
+    }
+};
+
+using ReferenceRunner = Runner<fcpp::core::reference::CPUImpl>;
+using CurrentRunner = Runner<fcpp::core::detail::CPUImpl>;
+
+static void printState(const char* const name, const State& state, const std::vector<std::uint32_t>& trace)
+{
+    std::printf("  %-9s pc %04x a %02x x %02x y %02x sp %02x p %02x i %02x, %u cycles, bus",
+        name, state.pc, state.regs[0], state.regs[1], state.regs[2], state.regs[3], state.regs[4], state.regs[5], trace.back());
+    for (std::size_t k = 0; k + 1 < trace.size(); k++)
+    {
+        if (trace[k] >> 24) std::printf(" w%04x=%02x", trace[k] & 0xffff, (trace[k] >> 16) & 0xff);
+        else std::printf(" r%04x", trace[k]);
+    }
+    std::printf("\n");
+}
+
+static bool compare(ReferenceRunner& reference, CurrentRunner& current, const State& state, const int count, unsigned long& failures)
+{
+    reference.run(state, count);
+    current.run(state, count);
+    if (reference.result == current.result && reference.trace == current.trace) return true;
+
+    if (failures++ < 16)
+    {
+        std::printf("mismatch at opcode %02x operand %02x\n", memory.data[state.pc], memory.data[state.pc + 1]);
+        printState("start", state, std::vector<std::uint32_t>{ 0 });
+        printState("reference", reference.result, reference.trace);
+        printState("current", current.result, current.trace);
+    }
+    return false;
+}
+
+/*
+* Every opcode runs on the reference and the current CPU with every A and operand value and a set of status values,
+* then every status value goes through NMI, IRQ and the instruction after them.
+* Registers, the status byte, the bus traffic and the cycles have to match exactly.
+* Afterwards both CPUs run the same loop alone to compare their speed.
+*/
+int main()
+{
+    static const std::uint8_t statuses[] = { 0x20, 0x21, 0x22, 0x23, 0x60, 0xa0, 0xe3, 0xff, 0xde, 0x3c };
+    // none, NMI or IRQ detected, NMI or IRQ requested
+    static const std::uint8_t internals[] = { 0x00, 0x20, 0x40, 0x08, 0x10 };
+
+    fcpp::core::Bus bus{};
+    fcpp::core::Clock clock{};
+    fcpp::core::Profiler profiler{};
+    ReferenceRunner reference{ &bus, &clock, &profiler };
+    CurrentRunner current{ &bus, &clock, &profiler };
+
+    unsigned long runs = 0, failures = 0;
+    for (int m = 0; m < 256; m++)
+    {
+        // the operands, pointers and stack all come from the operand value, the opcode sits at $0200
+        for (int addr = 0; addr < 0x10000; addr++) memory.data[addr] = static_cast<std::uint8_t>(m + (addr >> 12));
+        for (int op = 0; op < 256; op++)
+        {
+            memory.data[0x0200] = static_cast<std::uint8_t>(op);
+            for (int a = 0; a < 256; a++) for (auto p : statuses)
+            {
+                State state{ 0x0200, { static_cast<std::uint8_t>(a), static_cast<std::uint8_t>(a * 7 + m), static_cast<std::uint8_t>(a ^ m ^ 0x96), 0xfd, p, 0 } };
+                compare(reference, current, state, 1, failures);
+                runs++;
+            }
+            for (auto i : internals)
+            {
+                State state{ 0x0200, { static_cast<std::uint8_t>(op ^ m), 3, 0x80, 0xfd, static_cast<std::uint8_t>(m), i } };
+                compare(reference, current, state, 2, failures);
+                runs++;
+            }
+        }
+        std::fprintf(stderr, "operand %02x\r", m);
+    }
+    std::printf("%lu runs, %lu mismatches\n", runs, failures);
+
+    // a table walk with arithmetic, compares, shifts, flag pushes and branches
+    static const std::uint8_t program[] = {
+        0xb5, 0x10,       // LDA $10,X
+        0x69, 0x37,       // ADC #$37
+        0x95, 0x10,       // STA $10,X
+        0xc9, 0x80,       // CMP #$80
+        0x2a,             // ROL
+        0x45, 0x20,       // EOR $20
+        0x85, 0x20,       // STA $20
+        0x29, 0x0f,       // AND #$0f
+        0xf0, 0x01,       // BEQ +1
+        0xc8,             // INY
+        0xe8,             // INX
+        0xe0, 0x40,       // CPX #$40
+        0xd0, 0xe9,       // BNE $8000
+        0xa2, 0x00,       // LDX #$00
+        0x24, 0x30,       // BIT $30
+        0x08, 0x28,       // PHP, PLP
+        0x4c, 0x00, 0x80  // JMP $8000
+    };
+    constexpr long Instructions = 20000000;
+    // both start from the same memory, so they run the same instructions
+    auto load = []() {
+        std::memset(memory.data, 0, sizeof(memory.data));
+        std::memcpy(memory.data + 0x8000, program, sizeof(program));
+    };
+    double referenceTime = 1e9, currentTime = 1e9;
+    for (int round = 0; round < 5; round++)
+    {
+        load();
+        referenceTime = std::min(referenceTime, reference.bench(Instructions));
+        load();
+        currentTime = std::min(currentTime, current.bench(Instructions));
+    }
+    std::printf("reference %.2f ns, current %.2f ns per instruction, %.1f%% faster\n",
+        referenceTime / Instructions * 1e9, currentTime / Instructions * 1e9, (referenceTime / currentTime - 1.0) * 100.0);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "FCPP/Core.hpp"
+#include "FCPP/Tools/Netplay.hpp"
+
+struct TestIO :
+    public fcpp::core::FrameBuffer,
+    public fcpp::core::SampleBuffer
+{
+    TestIO() = default;
+    ~TestIO() override = default;
+
+    void setPixel(int /* x */, int /* y */, std::uint32_t /* color */) noexcept override {}
+    void completedSignal() noexcept override
+    {
+        completed = true;
+    }
+    const std::uint32_t* getPaletteTable() noexcept override
+    {
+        return nullptr;
+    }
+
+    void sendSample(double /* sample */) noexcept override {}
+    int getSampleRate() noexcept override
+    {
+        return 44100;
+    }
+
+    bool completed = false;
+};
+
+// replays the inputs a peer ended up with, frame by frame
+struct TestInput : public fcpp::core::InputScanner
+{
+    TestInput() = default;
+    ~TestInput() override = default;
+
+    std::uint8_t scan() noexcept override
+    {
+        return input;
+    }
+    fcpp::core::JoypadType getJoypadType() noexcept override
+    {
+        return fcpp::core::JoypadType::Standard;
+    }
+
+    std::uint8_t input = 0;
+};
+
+struct Peer
+{
+    fcpp::core::FC fc{};
+    fcpp::tools::LoopbackTransport transport{};
+    fcpp::tools::Netplay netplay{};
+    TestIO io{};
+    std::vector<std::uint8_t> inputs{};
+
+    bool load(const char* const path, const int localPort)
+    {
+        if (!fc.insertCartridge(path)) return false;
+        netplay.connect(&fc, &transport, localPort);
+        netplay.connect(static_cast<fcpp::core::FrameBuffer*>(&io));
+        netplay.connect(static_cast<fcpp::core::SampleBuffer*>(&io));
+        fc.powerOn();
+        return true;
+    }
+    bool exec(const std::uint8_t input)
+    {
+        if (!netplay.exec(input)) return false;
+        inputs.push_back(input);
+        return true;
+    }
+};
+
+static std::uint8_t nextInput(std::uint32_t& seed) noexcept
+{
+    seed = seed * 1103515245 + 12345;
+    return static_cast<std::uint8_t>(seed >> 16);
+}
+
+/*
+* Two peers run over a loopback transport, the second one lagging behind by a varying number of frames,
+* so the first one keeps rolling back. Both have to end up with the same state as a machine that ran the
+* same inputs alone. Afterwards the second peer stalls for as long as the first may lead and then changes
+* its input, so every exchange rolls back the whole way, and the longest rollback is reported against
+* Netplay::RollbackBudget.
+*/
+int main(int argc, char* argv[])
+{
+    constexpr int Frames = 600;
+    constexpr int TailFrames = 2 * fcpp::tools::Netplay::MaxRollbackFrames;
+    constexpr int Rounds = 120;
+
+    auto path = argc > 1 ? argv[argc - 1] : TEST_ROM_LOAD_PATH;
+    std::printf("Load: %s\n", path);
+
+    Peer a{}, b{};
+    if (!a.load(path, 0) || !b.load(path, 1))
+    {
+        std::printf("Failed to load rom\n");
+        return 1;
+    }
+    fcpp::tools::LoopbackTransport::pair(a.transport, b.transport);
+
+    std::uint32_t seedA = 1, seedB = 2, seedLag = 3;
+    std::uint8_t inputA = 0, inputB = 0;
+    while (a.inputs.size() < Frames || b.inputs.size() < Frames)
+    {
+        // hold a button for a few frames, the way a player would
+        if ((nextInput(seedA) & 3) == 0) inputA = nextInput(seedA);
+        if ((nextInput(seedB) & 3) == 0) inputB = nextInput(seedB);
+        if (a.inputs.size() < Frames) a.exec(inputA);
+        auto lag = nextInput(seedLag) % fcpp::tools::Netplay::MaxRollbackFrames;
+        if (b.inputs.size() < Frames && (lag < 4 || b.inputs.size() + lag < a.inputs.size())) b.exec(inputB);
+    }
+    // with a constant input at the end, the last predictions are right and nothing is left to roll back
+    for (int k = 0; k < TailFrames; k++)
+    {
+        while (!a.exec(0)) b.netplay.poll();
+        while (!b.exec(0)) a.netplay.poll();
+    }
+    a.netplay.poll();
+    b.netplay.poll();
+
+    // the same inputs without netplay
+    fcpp::core::FC reference{};
+    TestIO io{};
+    TestInput input[2]{};
+    reference.insertCartridge(path);
+    reference.connect(0, &input[0]);
+    reference.connect(1, &input[1]);
+    reference.connect(static_cast<fcpp::core::FrameBuffer*>(&io));
+    reference.connect(static_cast<fcpp::core::SampleBuffer*>(&io));
+    reference.powerOn();
+    for (std::size_t f = 0; f < a.inputs.size(); f++)
+    {
+        input[0].input = a.inputs[f];
+        input[1].input = b.inputs[f];
+        io.completed = false;
+        while (!io.completed) reference.exec();
+    }
+
+    auto hashA = a.fc.getStateHash(), hashB = b.fc.getStateHash(), hashReference = reference.getStateHash();
+    auto passed = a.netplay.getFrame() == b.netplay.getFrame() && hashA == hashB && hashA == hashReference;
+    std::printf("%u frames, %llu rolled back, state hash %016llx %016llx, alone %016llx: %s\n",
+        a.netplay.getFrame(), static_cast<unsigned long long>(a.netplay.getRollbackFrames()),
+        static_cast<unsigned long long>(hashA), static_cast<unsigned long long>(hashB),
+        static_cast<unsigned long long>(hashReference), passed ? "match" : "MISMATCH");
+
+    // the first peer leads by the most it may, then every input of the second one is a misprediction
+    std::uint64_t fullRollbacks = 0;
+    for (int round = 0; round < Rounds; round++)
+    {
+        while (a.exec(0));
+        for (int k = 0; k < fcpp::tools::Netplay::MaxRollbackFrames; k++) b.exec(static_cast<std::uint8_t>(k & 1 ? 0x10 : 0x20));
+        auto before = a.netplay.getRollbackFrames();
+        a.exec(0);
+        if (a.netplay.getRollbackFrames() - before >= fcpp::tools::Netplay::MaxRollbackFrames) fullRollbacks++;
+    }
+    auto rollbackTime = a.netplay.getMaxRollbackTime();
+    std::printf("%llu rollbacks of %d frames, longest %.2f ms, budget %.1f ms: %s\n",
+        static_cast<unsigned long long>(fullRollbacks), fcpp::tools::Netplay::MaxRollbackFrames,
+        rollbackTime, fcpp::tools::Netplay::RollbackBudget,
+        rollbackTime <= fcpp::tools::Netplay::RollbackBudget ? "within budget" : "over budget");
+
+    return passed ? 0 : 1;
+}
@@ -2,5 +2,8 @@
 #define FCPP_TOOLS_HPP
 
 #include "FCPP/Tools/Debugger.hpp"
+#include "FCPP/Tools/Movie.hpp"
+#include "FCPP/Tools/Netplay.hpp"
+#include "FCPP/Tools/Transport.hpp"
 
 #endif
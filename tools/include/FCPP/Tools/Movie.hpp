@@ -0,0 +1,121 @@
+#ifndef FCPP_TOOLS_MOVIE_HPP
+#define FCPP_TOOLS_MOVIE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <FCPPTOOLSExport.hpp>
+
+#include "FCPP/Core/FC.hpp"
+
+namespace fcpp::tools
+{
+    class Movie;
+    class MovieRecorder;
+    class MoviePlayer;
+}
+
+/*
+* Recorded input of both joypads, one byte per joypad per frame.
+* A movie starts either from power on or from a snapshot, and keeps a hash of the machine state
+* every hash interval frames so playback can verify determinism.
+*/
+class fcpp::tools::Movie
+{
+private:
+    struct MovieData;
+public:
+    // bumped whenever the layout or the meaning of the stored hashes changes
+    static constexpr std::uint32_t Version = 2;
+    static constexpr std::uint32_t DefaultHashInterval = 60;
+public:
+    // 64-bit FNV-1a
+    FCPP_TOOLS_EXPORT static std::uint64_t hash(const std::uint8_t* data, std::size_t size) noexcept;
+    // ROM hash of a movie, over the PRG and CHR rom without the header, so it does not change with the header revision
+    FCPP_TOOLS_EXPORT static std::uint64_t hash(const fcpp::core::INES& content) noexcept;
+public:
+    FCPP_TOOLS_EXPORT Movie();
+    FCPP_TOOLS_EXPORT Movie(Movie&&) noexcept;
+    FCPP_TOOLS_EXPORT ~Movie() noexcept;
+    FCPP_TOOLS_EXPORT Movie& operator=(Movie&&) noexcept;
+
+    // false for files of other format versions as well
+    FCPP_TOOLS_EXPORT bool load(const char* path);
+    FCPP_TOOLS_EXPORT bool save(const char* path) const;
+    // everything but the hash interval
+    FCPP_TOOLS_EXPORT void clear() noexcept;
+
+    FCPP_TOOLS_EXPORT void setROMHash(std::uint64_t hash) noexcept;
+    FCPP_TOOLS_EXPORT std::uint64_t getROMHash() const noexcept;
+    FCPP_TOOLS_EXPORT void setStartSnapshot(const fcpp::core::Snapshot& snapshot);
+    // nullptr if the movie starts from power on
+    FCPP_TOOLS_EXPORT const fcpp::core::Snapshot* getStartSnapshot() const noexcept;
+    // 0 disables frame hashes
+    FCPP_TOOLS_EXPORT void setHashInterval(std::uint32_t interval) noexcept;
+    FCPP_TOOLS_EXPORT std::uint32_t getHashInterval() const noexcept;
+
+    FCPP_TOOLS_EXPORT void append(std::uint8_t input0, std::uint8_t input1);
+    FCPP_TOOLS_EXPORT std::uint32_t getFrameCount() const noexcept;
+    FCPP_TOOLS_EXPORT std::uint8_t getInput(std::uint32_t frame, int idx) const noexcept;
+
+    // hash of the state after frame (idx + 1) * interval
+    FCPP_TOOLS_EXPORT void appendHash(std::uint64_t hash);
+    FCPP_TOOLS_EXPORT std::size_t getHashCount() const noexcept;
+    FCPP_TOOLS_EXPORT std::uint64_t getHash(std::size_t idx) const noexcept;
+private:
+    std::unique_ptr<MovieData> dptr;
+};
+
+// record the input scanned by the connected joypads, once per frame
+class fcpp::tools::MovieRecorder
+{
+private:
+    struct MovieRecorderData;
+public:
+    FCPP_TOOLS_EXPORT MovieRecorder();
+    FCPP_TOOLS_EXPORT ~MovieRecorder() noexcept;
+
+    // take over the joypads and outputs of fc
+    FCPP_TOOLS_EXPORT void connect(fcpp::core::FC* fc, Movie* movie) noexcept;
+    FCPP_TOOLS_EXPORT void connect(int idx, fcpp::core::InputScanner* inputScanner) noexcept;
+    FCPP_TOOLS_EXPORT void connect(fcpp::core::FrameBuffer* frameBuffer) noexcept;
+    FCPP_TOOLS_EXPORT void connect(fcpp::core::SampleBuffer* sampleBuffer) noexcept;
+
+    // clear the movie, set its ROM hash and start recording, from power on of a freshly inserted cartridge or from the current state
+    FCPP_TOOLS_EXPORT void start(bool fromSnapshot = false);
+    FCPP_TOOLS_EXPORT void stop() noexcept;
+    FCPP_TOOLS_EXPORT bool isRecording() const noexcept;
+private:
+    std::unique_ptr<MovieRecorderData> dptr;
+};
+
+// replay a movie as fast as possible, video and audio are discarded unless connected
+class fcpp::tools::MoviePlayer
+{
+private:
+    struct MoviePlayerData;
+public:
+    FCPP_TOOLS_EXPORT MoviePlayer();
+    FCPP_TOOLS_EXPORT ~MoviePlayer() noexcept;
+
+    // take over the joypads and outputs of fc and rewind, a movie starting from power on needs a freshly inserted cartridge
+    FCPP_TOOLS_EXPORT void connect(fcpp::core::FC* fc, const Movie* movie) noexcept;
+    FCPP_TOOLS_EXPORT void connect(fcpp::core::FrameBuffer* frameBuffer) noexcept;
+    FCPP_TOOLS_EXPORT void connect(fcpp::core::SampleBuffer* sampleBuffer) noexcept;
+    FCPP_TOOLS_EXPORT void setVerify(bool enable) noexcept;
+
+    // restart from the beginning of the movie
+    FCPP_TOOLS_EXPORT void rewind() noexcept;
+    // play at most frames frames, false on hash mismatch or end of movie
+    FCPP_TOOLS_EXPORT bool play(std::uint32_t frames = 0xffffffff) noexcept;
+
+    FCPP_TOOLS_EXPORT std::uint32_t getFrame() const noexcept;
+    FCPP_TOOLS_EXPORT bool isFinished() const noexcept;
+    // first frame whose hash differs from the movie, 0 if none
+    FCPP_TOOLS_EXPORT std::uint32_t getMismatchFrame() const noexcept;
+private:
+    std::unique_ptr<MoviePlayerData> dptr;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef FCPP_TOOLS_NETPLAY_HPP
+#define FCPP_TOOLS_NETPLAY_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include <FCPPTOOLSExport.hpp>
+
+#include "FCPP/Core/FC.hpp"
+#include "FCPP/Tools/Transport.hpp"
+
+namespace fcpp::tools
+{
+    class Netplay;
+}
+
+/*
+* Two player rollback session.
+* Remote input is predicted by repeating the last confirmed one. When a confirmed input differs from
+* the prediction, the machine is loaded from the snapshot of that frame and resimulated with audio and
+* video suppressed. Both peers must start from the same state with the same cartridge.
+*/
+class fcpp::tools::Netplay
+{
+private:
+    struct NetplayData;
+public:
+    static constexpr int MaxRollbackFrames = 8;
+    // ms a rollback of MaxRollbackFrames frames has to fit in, so a 60 fps frame can still be presented
+    static constexpr double RollbackBudget = 16.0;
+public:
+    FCPP_TOOLS_EXPORT Netplay();
+    FCPP_TOOLS_EXPORT ~Netplay() noexcept;
+
+    // take over the joypads and outputs of fc, localPort is the joypad index of the local player
+    FCPP_TOOLS_EXPORT void connect(fcpp::core::FC* fc, Transport* transport, int localPort) noexcept;
+    FCPP_TOOLS_EXPORT void connect(fcpp::core::FrameBuffer* frameBuffer) noexcept;
+    FCPP_TOOLS_EXPORT void connect(fcpp::core::SampleBuffer* sampleBuffer) noexcept;
+
+    // emulate one frame with local input, false if waiting for the remote peer
+    FCPP_TOOLS_EXPORT bool exec(std::uint8_t input) noexcept;
+    // exchange input without emulating
+    FCPP_TOOLS_EXPORT void poll() noexcept;
+
+    FCPP_TOOLS_EXPORT std::uint32_t getFrame() const noexcept;
+    // last frame whose remote input has been received
+    FCPP_TOOLS_EXPORT std::uint32_t getConfirmedFrame() const noexcept;
+    FCPP_TOOLS_EXPORT std::uint64_t getRollbackFrames() const noexcept;
+    // longest rollback so far in ms, loading the snapshot and resimulating, compare with RollbackBudget
+    FCPP_TOOLS_EXPORT double getMaxRollbackTime() const noexcept;
+private:
+    std::unique_ptr<NetplayData> dptr;
+};
+
+#endif
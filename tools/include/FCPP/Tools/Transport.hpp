@@ -0,0 +1,64 @@
+#ifndef FCPP_TOOLS_TRANSPORT_HPP
+#define FCPP_TOOLS_TRANSPORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <FCPPTOOLSExport.hpp>
+
+namespace fcpp::tools
+{
+    class Transport;
+    class LoopbackTransport;
+    class UDPTransport;
+}
+
+// unreliable datagram channel to a single peer, both calls never block
+class fcpp::tools::Transport
+{
+public:
+    Transport() = default;
+    virtual ~Transport() = default;
+
+    virtual bool send(const std::uint8_t* data, std::size_t size) noexcept = 0;
+    // size of the received datagram, 0 if nothing is pending
+    virtual std::size_t receive(std::uint8_t* buffer, std::size_t capacity) noexcept = 0;
+};
+
+// in-process stand-in for a network connection
+class fcpp::tools::LoopbackTransport : public fcpp::tools::Transport
+{
+private:
+    struct LoopbackTransportData;
+public:
+    FCPP_TOOLS_EXPORT static void pair(LoopbackTransport& a, LoopbackTransport& b);
+public:
+    FCPP_TOOLS_EXPORT LoopbackTransport();
+    FCPP_TOOLS_EXPORT ~LoopbackTransport() noexcept override;
+
+    FCPP_TOOLS_EXPORT bool send(const std::uint8_t* data, std::size_t size) noexcept override;
+    FCPP_TOOLS_EXPORT std::size_t receive(std::uint8_t* buffer, std::size_t capacity) noexcept override;
+private:
+    std::unique_ptr<LoopbackTransportData> dptr;
+};
+
+class fcpp::tools::UDPTransport : public fcpp::tools::Transport
+{
+private:
+    struct UDPTransportData;
+public:
+    FCPP_TOOLS_EXPORT UDPTransport();
+    FCPP_TOOLS_EXPORT ~UDPTransport() noexcept override;
+
+    // bind localPort and send to host:port
+    FCPP_TOOLS_EXPORT bool open(std::uint16_t localPort, const char* host, std::uint16_t port) noexcept;
+    FCPP_TOOLS_EXPORT void close() noexcept;
+
+    FCPP_TOOLS_EXPORT bool send(const std::uint8_t* data, std::size_t size) noexcept override;
+    FCPP_TOOLS_EXPORT std::size_t receive(std::uint8_t* buffer, std::size_t capacity) noexcept override;
+private:
+    std::unique_ptr<UDPTransportData> dptr;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "FCPP/Core.hpp"
+#include "FCPP/IO/Recorder.hpp"
+#include "FCPP/Tools.hpp"
+
+static void usage()
+{
+    std::cout << "usage: fcpp_movie_player <options> rom movie\n\n"
+        "--no_verify\n  Skip frame hash verification\n"
+        "--loop\n  Play the movie n times\n"
+        "--record_video\n  Render the movie to a video file, Y4M if the file name ends with .y4m, raw 24-bit RGB otherwise\n"
+        "--record_audio\n  Render the movie to a 16-bit mono WAV file\n"
+        "--record_every\n  Record every n-th frame only\n" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* romPath = nullptr;
+    const char* moviePath = nullptr;
+    const char* videoPath = nullptr;
+    const char* audioPath = nullptr;
+    bool verify = true;
+    int loop = 1;
+    int recordEvery = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!std::strcmp(argv[i], "--no_verify")) verify = false;
+        else if (!std::strcmp(argv[i], "--loop") && i + 1 < argc) loop = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--record_video") && i + 1 < argc) videoPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--record_audio") && i + 1 < argc) audioPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--record_every") && i + 1 < argc) recordEvery = std::atoi(argv[++i]);
+        else if (argv[i][0] == '-')
+        {
+            usage();
+            return 0;
+        }
+        else if (romPath == nullptr) romPath = argv[i];
+        else moviePath = argv[i];
+    }
+    if (moviePath == nullptr)
+    {
+        usage();
+        return 0;
+    }
+
+    std::size_t size = 0;
+    auto image = fcpp::core::INES::map(romPath, size);
+    fcpp::core::INES content{};
+    if (!image || !content.load(image, size))
+    {
+        std::cerr << "Failed to load ROM file: " << romPath << std::endl;
+        return 1;
+    }
+    fcpp::tools::Movie movie{};
+    if (!movie.load(moviePath))
+    {
+        std::cerr << "Failed to load movie file: " << moviePath << " (missing, damaged or not of movie format version " << fcpp::tools::Movie::Version << ")" << std::endl;
+        return 1;
+    }
+    if (movie.getROMHash() != fcpp::tools::Movie::hash(content))
+        std::cerr << "Warning: the movie was recorded with a different ROM" << std::endl;
+
+    fcpp::core::FC fc{};
+    fc.insertCartridge(std::move(content));
+
+    fcpp::tools::MoviePlayer player{};
+    player.setVerify(verify);
+    player.connect(&fc, &movie);
+
+    // headless, every frame is written however long the writer takes
+    fcpp::io::Recorder recorder{};
+    if (videoPath != nullptr || audioPath != nullptr)
+    {
+        std::string path = videoPath != nullptr ? videoPath : "";
+        auto format = path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0 ?
+            fcpp::io::Recorder::VideoFormat::Y4M : fcpp::io::Recorder::VideoFormat::RGB;
+        recorder.setBlocking(true);
+        player.connect(recorder.tap(static_cast<fcpp::core::FrameBuffer*>(nullptr)));
+        player.connect(recorder.tap(static_cast<fcpp::core::SampleBuffer*>(nullptr)));
+        if (!recorder.start(videoPath, format, audioPath, recordEvery))
+        {
+            std::cerr << "Failed to open recording files" << std::endl;
+            return 1;
+        }
+    }
+
+    std::uint64_t frames = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loop; i++)
+    {
+        if (i) player.rewind();
+        while (player.play(600));
+        frames += player.getFrame();
+        if (player.getMismatchFrame())
+        {
+            std::cerr << "Desync at frame " << player.getMismatchFrame() << " of pass " << i + 1 << std::endl;
+            return 1;
+        }
+    }
+    recorder.stop();
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+    std::cout << frames << " frames in " << time.count() << "s, " << frames / time.count() << "fps" << std::endl;
+    return 0;
+}
@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "FCPP/Core.hpp"
+#include "FCPP/Tools.hpp"
+
+struct TestIO :
+    public fcpp::core::FrameBuffer,
+    public fcpp::core::SampleBuffer,
+    public fcpp::core::InputScanner
+{
+    TestIO() = default;
+    ~TestIO() override = default;
+
+    void setPixel(int /* x */, int /* y */, std::uint32_t /* color */) noexcept override {}
+    void completedSignal() noexcept override
+    {
+        completed = true;
+    }
+    const std::uint32_t* getPaletteTable() noexcept override
+    {
+        return nullptr;
+    }
+
+    void sendSample(double /* sample */) noexcept override {}
+    int getSampleRate() noexcept override
+    {
+        return 44100;
+    }
+
+    std::uint8_t scan() noexcept override
+    {
+        return 0;
+    }
+    fcpp::core::JoypadType getJoypadType() noexcept override
+    {
+        return fcpp::core::JoypadType::Standard;
+    }
+
+    bool completed = false;
+};
+
+struct Options
+{
+    std::string dir{};
+    std::string goldenPath{};
+    std::string writeGoldenPath{};
+    std::string reportPath{};
+    unsigned int jobs = std::max(std::thread::hardware_concurrency(), 1u);
+    std::uint32_t frames = 600;
+    std::uint32_t interval = 60;
+};
+
+struct Job
+{
+    std::string name;
+    std::string romPath;
+    std::string moviePath;
+};
+
+// frame hashes are chained, a checkpoint is kept every interval frames to locate divergences
+struct Result
+{
+    enum class Status
+    {
+        Passed, New, Diverged, Desync, LoadFailed
+    };
+
+    Status status = Status::Passed;
+    std::uint32_t frames = 0;
+    std::uint32_t divergenceFrame = 0;
+    double fps = 0.0;
+    std::uint64_t stateHash = 0;
+    std::vector<std::uint64_t> checkpoints{};
+};
+
+struct Golden
+{
+    std::uint32_t frames = 0;
+    std::uint64_t stateHash = 0;
+    std::vector<std::uint64_t> checkpoints{};
+};
+
+static void usage()
+{
+    std::cout << "usage: fcpp_regression <options> dir\n\n"
+        "Run every .nes file in dir, playing dir/<name>.fcm if it exists\n\n"
+        "--jobs\n  Number of worker threads, default to the number of cores\n"
+        "--frames\n  Frames to run for ROMs without movie, default to 600\n"
+        "--golden\n  Compare results with a golden file\n"
+        "--write_golden\n  Write results as a new golden file\n"
+        "--report\n  Write the summary report to a file instead of stdout\n" << std::endl;
+}
+
+static std::uint64_t chain(const std::uint64_t hash, const std::uint64_t value) noexcept
+{
+    return (hash ^ value) * 0x100000001b3;
+}
+
+static void run(const Job& job, const Options& options, Result& result)
+{
+    fcpp::core::FC fc{};
+    TestIO io{};
+    fcpp::tools::Movie movie{};
+    fcpp::tools::MoviePlayer player{};
+    bool withMovie = !job.moviePath.empty();
+
+    if (!fc.insertCartridge(job.romPath.c_str()) || (withMovie && !movie.load(job.moviePath.c_str())))
+    {
+        result.status = Result::Status::LoadFailed;
+        return;
+    }
+
+    fc.setFrameHash(true);
+    if (withMovie) player.connect(&fc, &movie);
+    else
+    {
+        fc.connect(0, &io);
+        fc.connect(static_cast<fcpp::core::FrameBuffer*>(&io));
+        fc.connect(static_cast<fcpp::core::SampleBuffer*>(&io));
+        fc.powerOn();
+    }
+
+    std::uint64_t hash = 0xcbf29ce484222325;
+    auto frames = withMovie ? movie.getFrameCount() : options.frames;
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint32_t frame = 1; frame <= frames; frame++)
+    {
+        if (withMovie) player.play(1);
+        else for (io.completed = false; !io.completed;) fc.exec();
+
+        hash = chain(hash, fc.getFrameHash());
+        if (frame % options.interval == 0) result.checkpoints.push_back(hash);
+        if (withMovie && player.getMismatchFrame())
+        {
+            result.status = Result::Status::Desync;
+            result.divergenceFrame = player.getMismatchFrame();
+            break;
+        }
+        result.frames = frame;
+    }
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+    result.fps = time.count() > 0.0 ? result.frames / time.count() : 0.0;
+    result.stateHash = fc.getStateHash();
+}
+
+static void compare(const Golden& golden, const Options& options, Result& result)
+{
+    if (result.status != Result::Status::Passed) return;
+
+    auto count = std::min(golden.checkpoints.size(), result.checkpoints.size());
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (golden.checkpoints[i] != result.checkpoints[i])
+        {
+            result.status = Result::Status::Diverged;
+            result.divergenceFrame = static_cast<std::uint32_t>(i + 1) * options.interval;
+            return;
+        }
+    }
+    if (golden.frames != result.frames || golden.stateHash != result.stateHash)
+    {
+        result.status = Result::Status::Diverged;
+        result.divergenceFrame = std::min(golden.frames, result.frames);
+    }
+}
+
+// one line per ROM: name, frame count, state hash, checkpoints, separated by tabs
+static bool readGolden(const std::string& path, std::unordered_map<std::string, Golden>& goldens)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    std::string line{};
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string name{};
+        Golden golden{};
+        if (!std::getline(fields, name, '\t') || !(fields >> golden.frames >> std::hex >> golden.stateHash)) continue;
+        for (std::uint64_t checkpoint = 0; fields >> checkpoint;) golden.checkpoints.push_back(checkpoint);
+        goldens[name] = std::move(golden);
+    }
+    return true;
+}
+
+static bool writeGolden(const std::string& path, const std::vector<Job>& jobs, const std::vector<Result>& results)
+{
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    for (std::size_t i = 0; i < jobs.size(); i++)
+    {
+        if (results[i].status == Result::Status::LoadFailed || results[i].status == Result::Status::Desync) continue;
+        file << jobs[i].name << '\t' << results[i].frames << std::hex << ' ' << results[i].stateHash;
+        for (auto checkpoint : results[i].checkpoints) file << ' ' << checkpoint;
+        file << std::dec << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+static void report(std::ostream& stream, const std::vector<Job>& jobs, const std::vector<Result>& results, const double time)
+{
+    static const char* const statusName[] = { "passed", "new", "diverged", "desync", "load failed" };
+
+    std::size_t count[sizeof(statusName) / sizeof(statusName[0])]{};
+    std::uint64_t frames = 0;
+    for (std::size_t i = 0; i < jobs.size(); i++)
+    {
+        auto& result = results[i];
+        count[static_cast<int>(result.status)]++;
+        frames += result.frames;
+
+        stream << std::left << std::setw(12) << statusName[static_cast<int>(result.status)] << ' ' << jobs[i].name;
+        if (result.status == Result::Status::LoadFailed)
+        {
+            stream << '\n';
+            continue;
+        }
+        stream << ", " << result.frames << " frames, " << std::fixed << std::setprecision(1) << result.fps << "fps, state " << std::hex << result.stateHash << std::dec;
+        if (result.divergenceFrame) stream << ", diverged by frame " << result.divergenceFrame;
+        stream << '\n';
+    }
+
+    stream << '\n' << jobs.size() << " ROMs in " << std::fixed << std::setprecision(2) << time << "s, " << frames << " frames, " << frames / time << "fps total\n";
+    for (std::size_t i = 0; i < sizeof(statusName) / sizeof(statusName[0]); i++) stream << statusName[i] << ": " << count[i] << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    Options options{};
+    for (int i = 1; i < argc; i++)
+    {
+        if (!std::strcmp(argv[i], "--jobs") && i + 1 < argc) options.jobs = std::max(std::atoi(argv[++i]), 1);
+        else if (!std::strcmp(argv[i], "--frames") && i + 1 < argc) options.frames = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--golden") && i + 1 < argc) options.goldenPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--write_golden") && i + 1 < argc) options.writeGoldenPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--report") && i + 1 < argc) options.reportPath = argv[++i];
+        else if (argv[i][0] == '-')
+        {
+            usage();
+            return 0;
+        }
+        else options.dir = argv[i];
+    }
+    if (options.dir.empty())
+    {
+        usage();
+        return 0;
+    }
+
+    std::vector<Job> jobs{};
+    std::error_code error{};
+    for (auto& entry : std::filesystem::directory_iterator(options.dir, error))
+    {
+        auto path = entry.path();
+        if (!entry.is_regular_file() || path.extension() != ".nes") continue;
+
+        auto moviePath = path;
+        moviePath.replace_extension(".fcm");
+        jobs.push_back({ path.filename().string(), path.string(), std::filesystem::exists(moviePath) ? moviePath.string() : std::string{} });
+    }
+    if (error)
+    {
+        std::cerr << "Failed to read directory: " << options.dir << std::endl;
+        return 1;
+    }
+    std::sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.name < b.name; });
+
+    std::unordered_map<std::string, Golden> goldens{};
+    if (!options.goldenPath.empty() && !readGolden(options.goldenPath, goldens))
+    {
+        std::cerr << "Failed to load golden file: " << options.goldenPath << std::endl;
+        return 1;
+    }
+
+    std::vector<Result> results(jobs.size());
+    std::atomic<std::size_t> next = 0;
+    auto worker = [&]() {
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < jobs.size();)
+        {
+            run(jobs[i], options, results[i]);
+            if (options.goldenPath.empty()) continue;
+            if (auto golden = goldens.find(jobs[i].name); golden != goldens.end()) compare(golden->second, options, results[i]);
+            else if (results[i].status == Result::Status::Passed) results[i].status = Result::Status::New;
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads{};
+    auto threadCount = std::min<std::size_t>(options.jobs, jobs.size());
+    for (std::size_t i = 1; i < threadCount; i++) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+    std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+    if (!options.writeGoldenPath.empty() && !writeGolden(options.writeGoldenPath, jobs, results))
+        std::cerr << "Failed to write golden file: " << options.writeGoldenPath << std::endl;
+
+    if (options.reportPath.empty()) report(std::cout, jobs, results, time.count());
+    else
+    {
+        std::ofstream file(options.reportPath);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to write report: " << options.reportPath << std::endl;
+            return 1;
+        }
+        report(file, jobs, results, time.count());
+    }
+
+    auto failed = std::any_of(results.begin(), results.end(), [](const Result& result) {
+        return result.status == Result::Status::Diverged || result.status == Result::Status::Desync || result.status == Result::Status::LoadFailed;
+    });
+    return failed ? 1 : 0;
+}
@@ -271,6 +271,7 @@ struct fcpp::tools::Debugger::DebuggerData
 {
     fcpp::core::CPU* cpu = nullptr;
     fcpp::core::Bus* bus = nullptr;
+    fcpp::core::Cartridge* cartridge = nullptr;
 
     std::unique_ptr<std::uint32_t[]> patternTableBuffer{};
 
@@ -296,6 +297,7 @@ void fcpp::tools::Debugger::connect(fcpp::core::FC* const fc) noexcept
 {
     dptr->cpu = fc->getCPU();
     dptr->bus = fc->getBus();
+    dptr->cartridge = fc->getCartridge();
 }
 
 fcpp::tools::Debugger::MemoryView fcpp::tools::Debugger::getRamView() const noexcept
@@ -322,8 +324,8 @@ fcpp::tools::Debugger::PatternTableView fcpp::tools::Debugger::getPatternTableVi
 {
     if (!dptr->patternTableBuffer) dptr->patternTableBuffer = std::make_unique<std::uint32_t[]>(32768);
     auto buffer = dptr->patternTableBuffer.get();
-    auto bus = dptr->bus;
-    auto pram = bus->dump<fcpp::core::Bus::MemoryType::PRAM>();
+    auto cartridge = dptr->cartridge;
+    auto pram = dptr->bus->dump<fcpp::core::Bus::MemoryType::PRAM>();
     return PatternTableView{ dptr->patternTableBuffer.get(), [=]()
         {
             for (int tile = 0; tile < 0x200; tile++)
@@ -333,18 +335,16 @@ fcpp::tools::Debugger::PatternTableView fcpp::tools::Debugger::getPatternTableVi
                 int pixelRow = (tile / 16) * 8;
                 int pixelPos = pixelRow * 16 * 8 + pixelCol;
 
-                std::uint8_t bytes[16] = {};
-                std::uint8_t* plane0 = bytes;
-                std::uint8_t* plane1 = bytes + 8;
-
-                for (int count = 0; count < 16; count++) bytes[count] = bus->read<fcpp::core::PPU>(tile * 16 + count);
-
-                for (int row = 0; row < 8; row++) for (int col = 0; col < 8; col++)
+                for (int row = 0; row < 8; row++)
                 {
-                    int paletteIdx = page | (((plane1[row] >> (7 - col)) & 1) << 1) | ((plane0[row] >> (7 - col)) & 1);
-                    int colorIdx = 0x3f & pram[paletteIdx];
-                    int pixelIdx = pixelPos + row * 16 * 8 + col;
-                    buffer[pixelIdx] = DebuggerData::paletteTable[colorIdx];
+                    auto pixels = cartridge->readPattern(static_cast<std::uint16_t>(tile * 16 + row)).pixels;
+                    for (int col = 0; col < 8; col++)
+                    {
+                        int paletteIdx = page | ((pixels >> (14 - col * 2)) & 3);
+                        int colorIdx = 0x3f & pram[paletteIdx];
+                        int pixelIdx = pixelPos + row * 16 * 8 + col;
+                        buffer[pixelIdx] = DebuggerData::paletteTable[colorIdx];
+                    }
                 }
             }
         }
@@ -0,0 +1,468 @@
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "FCPP/Tools/Movie.hpp"
+
+/*
+* Layout, all integers are little-endian:
+* 0-3: Constant "FCMV"
+* 4-7: Format version, only Movie::Version is read
+* 8-15: ROM hash
+* 16-19: Frame count
+* 20-23: Hash interval
+* 24-27: Hash count
+* 28-31: Start snapshot size, 0 if the movie starts from power on
+* Start snapshot
+* Inputs, two bytes per frame
+* Hashes, 8 bytes each
+*/
+namespace fcpp::tools::detail
+{
+    static constexpr char MovieMagic[] = { 'F', 'C', 'M', 'V' };
+    static constexpr std::size_t MovieHeaderSize = 32;
+
+    template<typename Integer>
+    inline static Integer readMovieInteger(const std::uint8_t* const data) noexcept
+    {
+        Integer value = 0;
+        for (std::size_t i = 0; i < sizeof(Integer); i++) value |= static_cast<Integer>(data[i]) << (8 * i);
+        return value;
+    }
+    // 64-bit FNV-1a, continued from value
+    inline static std::uint64_t hashMovieData(std::uint64_t value, const std::uint8_t* const data, const std::size_t size) noexcept
+    {
+        for (std::size_t i = 0; i < size; i++)
+        {
+            value ^= data[i];
+            value *= 0x100000001b3;
+        }
+        return value;
+    }
+    template<typename Integer>
+    inline static void writeMovieInteger(std::vector<char>& buffer, const Integer value)
+    {
+        for (std::size_t i = 0; i < sizeof(Integer); i++) buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+
+    class MovieInput : public fcpp::core::InputScanner
+    {
+    public:
+        MovieInput() = default;
+        ~MovieInput() override = default;
+
+        std::uint8_t scan() noexcept override;
+        fcpp::core::JoypadType getJoypadType() noexcept override;
+    public:
+        fcpp::core::InputScanner* inputScanner = nullptr;
+        std::uint8_t input = 0;
+        bool latched = false;
+    };
+    std::uint8_t MovieInput::scan() noexcept
+    {
+        if (latched) return input;
+        return inputScanner != nullptr ? inputScanner->scan() : 0;
+    }
+    fcpp::core::JoypadType MovieInput::getJoypadType() noexcept
+    {
+        return fcpp::core::JoypadType::Standard;
+    }
+    inline static void latchMovieInput(MovieInput& movieInput) noexcept
+    {
+        movieInput.input = movieInput.inputScanner != nullptr ? movieInput.inputScanner->scan() : 0;
+    }
+
+    class MovieOutput :
+        public fcpp::core::FrameBuffer,
+        public fcpp::core::SampleBuffer
+    {
+    public:
+        MovieOutput() = default;
+        ~MovieOutput() override = default;
+
+        void setPixel(int x, int y, std::uint32_t color) noexcept override;
+        void completedSignal() noexcept override;
+        const std::uint32_t* getPaletteTable() noexcept override;
+        bool keepsLastFrame() noexcept override;
+        void setFrameUnchanged(bool unchanged) noexcept override;
+
+        void sendSample(double sample) noexcept override;
+        int getSampleRate() noexcept override;
+    public:
+        fcpp::core::FrameBuffer* frameBuffer = nullptr;
+        fcpp::core::SampleBuffer* sampleBuffer = nullptr;
+        void (*callback)(void*) = nullptr;
+        void* context = nullptr;
+    };
+    void MovieOutput::setPixel(const int x, const int y, const std::uint32_t color) noexcept
+    {
+        if (frameBuffer != nullptr) frameBuffer->setPixel(x, y, color);
+    }
+    void MovieOutput::completedSignal() noexcept
+    {
+        if (frameBuffer != nullptr) frameBuffer->completedSignal();
+        if (callback != nullptr) callback(context);
+    }
+    const std::uint32_t* MovieOutput::getPaletteTable() noexcept
+    {
+        return frameBuffer != nullptr ? frameBuffer->getPaletteTable() : nullptr;
+    }
+    bool MovieOutput::keepsLastFrame() noexcept
+    {
+        // without video nobody needs the pixels
+        return frameBuffer == nullptr || frameBuffer->keepsLastFrame();
+    }
+    void MovieOutput::setFrameUnchanged(const bool unchanged) noexcept
+    {
+        if (frameBuffer != nullptr) frameBuffer->setFrameUnchanged(unchanged);
+    }
+    void MovieOutput::sendSample(const double sample) noexcept
+    {
+        if (sampleBuffer != nullptr) sampleBuffer->sendSample(sample);
+    }
+    int MovieOutput::getSampleRate() noexcept
+    {
+        return sampleBuffer != nullptr ? sampleBuffer->getSampleRate() : 44100;
+    }
+}
+
+struct fcpp::tools::Movie::MovieData
+{
+    std::uint64_t romHash = 0;
+    std::uint32_t hashInterval = DefaultHashInterval;
+    std::unique_ptr<fcpp::core::Snapshot> snapshot{};
+    std::vector<std::uint8_t> inputs{};
+    std::vector<std::uint64_t> hashes{};
+};
+
+std::uint64_t fcpp::tools::Movie::hash(const std::uint8_t* const data, const std::size_t size) noexcept
+{
+    return detail::hashMovieData(0xcbf29ce484222325, data, size);
+}
+std::uint64_t fcpp::tools::Movie::hash(const fcpp::core::INES& content) noexcept
+{
+    auto value = hash(content.getPRGData(), content.getPRGSize());
+    // video ram is written by the game and is not part of the ROM
+    if (content.getCHRBanks()) value = detail::hashMovieData(value, content.getCHRData(), content.getCHRSize());
+    return value;
+}
+
+fcpp::tools::Movie::Movie() : dptr(std::make_unique<MovieData>()) {}
+fcpp::tools::Movie::Movie(Movie&&) noexcept = default;
+fcpp::tools::Movie::~Movie() noexcept = default;
+fcpp::tools::Movie& fcpp::tools::Movie::operator=(Movie&&) noexcept = default;
+
+bool fcpp::tools::Movie::load(const char* const path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::vector<std::uint8_t> buffer{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    if (buffer.size() < detail::MovieHeaderSize || !std::equal(std::begin(detail::MovieMagic), std::end(detail::MovieMagic), buffer.begin())) return false;
+
+    auto data = buffer.data();
+    // hashes of other versions may be computed differently and would fail to verify
+    if (detail::readMovieInteger<std::uint32_t>(data + 4) != Version) return false;
+    auto romHash = detail::readMovieInteger<std::uint64_t>(data + 8);
+    auto frameCount = detail::readMovieInteger<std::uint32_t>(data + 16);
+    auto hashInterval = detail::readMovieInteger<std::uint32_t>(data + 20);
+    auto hashCount = detail::readMovieInteger<std::uint32_t>(data + 24);
+    auto snapshotSize = detail::readMovieInteger<std::uint32_t>(data + 28);
+
+    std::unique_ptr<fcpp::core::Snapshot> snapshot{};
+    if (snapshotSize) snapshot = std::make_unique<fcpp::core::Snapshot>();
+    if ((snapshot && snapshotSize > snapshot->capacity()) ||
+        buffer.size() != detail::MovieHeaderSize + snapshotSize + frameCount * std::size_t{ 2 } + hashCount * std::size_t{ 8 }) return false;
+
+    data += detail::MovieHeaderSize;
+    if (snapshot)
+    {
+        std::copy(data, data + snapshotSize, snapshot->data());
+        snapshot->setSize(snapshotSize);
+        data += snapshotSize;
+    }
+    dptr->inputs.assign(data, data + frameCount * std::size_t{ 2 });
+    data += dptr->inputs.size();
+    dptr->hashes.resize(hashCount);
+    for (auto& value : dptr->hashes)
+    {
+        value = detail::readMovieInteger<std::uint64_t>(data);
+        data += 8;
+    }
+    dptr->romHash = romHash;
+    dptr->hashInterval = hashInterval;
+    dptr->snapshot = std::move(snapshot);
+    return true;
+}
+bool fcpp::tools::Movie::save(const char* const path) const
+{
+    std::uint32_t snapshotSize = dptr->snapshot ? static_cast<std::uint32_t>(dptr->snapshot->size()) : 0;
+
+    std::vector<char> buffer(detail::MovieMagic, detail::MovieMagic + sizeof(detail::MovieMagic));
+    buffer.reserve(detail::MovieHeaderSize + snapshotSize + dptr->inputs.size() + dptr->hashes.size() * 8);
+    detail::writeMovieInteger(buffer, Version);
+    detail::writeMovieInteger(buffer, dptr->romHash);
+    detail::writeMovieInteger(buffer, getFrameCount());
+    detail::writeMovieInteger(buffer, dptr->hashInterval);
+    detail::writeMovieInteger(buffer, static_cast<std::uint32_t>(dptr->hashes.size()));
+    detail::writeMovieInteger(buffer, snapshotSize);
+    if (snapshotSize) buffer.insert(buffer.end(), dptr->snapshot->data(), dptr->snapshot->data() + snapshotSize);
+    buffer.insert(buffer.end(), dptr->inputs.begin(), dptr->inputs.end());
+    for (auto value : dptr->hashes) detail::writeMovieInteger(buffer, value);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    return static_cast<bool>(file.write(buffer.data(), static_cast<std::streamsize>(buffer.size())));
+}
+void fcpp::tools::Movie::clear() noexcept
+{
+    dptr->romHash = 0;
+    dptr->snapshot.reset();
+    dptr->inputs.clear();
+    dptr->hashes.clear();
+}
+
+void fcpp::tools::Movie::setROMHash(const std::uint64_t hash) noexcept
+{
+    dptr->romHash = hash;
+}
+std::uint64_t fcpp::tools::Movie::getROMHash() const noexcept
+{
+    return dptr->romHash;
+}
+void fcpp::tools::Movie::setStartSnapshot(const fcpp::core::Snapshot& snapshot)
+{
+    dptr->snapshot = std::make_unique<fcpp::core::Snapshot>(snapshot);
+}
+const fcpp::core::Snapshot* fcpp::tools::Movie::getStartSnapshot() const noexcept
+{
+    return dptr->snapshot.get();
+}
+void fcpp::tools::Movie::setHashInterval(const std::uint32_t interval) noexcept
+{
+    dptr->hashInterval = interval;
+}
+std::uint32_t fcpp::tools::Movie::getHashInterval() const noexcept
+{
+    return dptr->hashInterval;
+}
+
+void fcpp::tools::Movie::append(const std::uint8_t input0, const std::uint8_t input1)
+{
+    dptr->inputs.push_back(input0);
+    dptr->inputs.push_back(input1);
+}
+std::uint32_t fcpp::tools::Movie::getFrameCount() const noexcept
+{
+    return static_cast<std::uint32_t>(dptr->inputs.size() / 2);
+}
+std::uint8_t fcpp::tools::Movie::getInput(const std::uint32_t frame, const int idx) const noexcept
+{
+    return frame < getFrameCount() ? dptr->inputs[frame * std::size_t{ 2 } + (idx & 1)] : 0;
+}
+
+void fcpp::tools::Movie::appendHash(const std::uint64_t hash)
+{
+    dptr->hashes.push_back(hash);
+}
+std::size_t fcpp::tools::Movie::getHashCount() const noexcept
+{
+    return dptr->hashes.size();
+}
+std::uint64_t fcpp::tools::Movie::getHash(const std::size_t idx) const noexcept
+{
+    return dptr->hashes[idx];
+}
+
+struct fcpp::tools::MovieRecorder::MovieRecorderData
+{
+    fcpp::core::FC* fc = nullptr;
+    Movie* movie = nullptr;
+    detail::MovieInput input[2]{};
+    detail::MovieOutput output{};
+    fcpp::core::Snapshot snapshot{};
+    std::uint32_t frame = 0;
+
+    static void frameCompleted(void* const context)
+    {
+        auto data = static_cast<MovieRecorderData*>(context);
+        if (!data->input[0].latched) return;
+
+        data->movie->append(data->input[0].input, data->input[1].input);
+        auto interval = data->movie->getHashInterval();
+        if (interval && ++data->frame % interval == 0) data->movie->appendHash(data->fc->getStateHash());
+        detail::latchMovieInput(data->input[0]);
+        detail::latchMovieInput(data->input[1]);
+    }
+};
+
+fcpp::tools::MovieRecorder::MovieRecorder() : dptr(std::make_unique<MovieRecorderData>())
+{
+    dptr->output.callback = MovieRecorderData::frameCompleted;
+    dptr->output.context = dptr.get();
+}
+fcpp::tools::MovieRecorder::~MovieRecorder() noexcept = default;
+
+void fcpp::tools::MovieRecorder::connect(fcpp::core::FC* const fc, Movie* const movie) noexcept
+{
+    stop();
+    dptr->fc = fc;
+    dptr->movie = movie;
+    fc->connect(0, &dptr->input[0]);
+    fc->connect(1, &dptr->input[1]);
+    fc->connect(static_cast<fcpp::core::FrameBuffer*>(&dptr->output));
+    fc->connect(static_cast<fcpp::core::SampleBuffer*>(&dptr->output));
+}
+void fcpp::tools::MovieRecorder::connect(const int idx, fcpp::core::InputScanner* const inputScanner) noexcept
+{
+    dptr->input[idx & 1].inputScanner = inputScanner;
+}
+void fcpp::tools::MovieRecorder::connect(fcpp::core::FrameBuffer* const frameBuffer) noexcept
+{
+    dptr->output.frameBuffer = frameBuffer;
+    if (dptr->fc != nullptr) dptr->fc->connect(static_cast<fcpp::core::FrameBuffer*>(&dptr->output));
+}
+void fcpp::tools::MovieRecorder::connect(fcpp::core::SampleBuffer* const sampleBuffer) noexcept
+{
+    dptr->output.sampleBuffer = sampleBuffer;
+    if (dptr->fc != nullptr) dptr->fc->connect(static_cast<fcpp::core::SampleBuffer*>(&dptr->output));
+}
+
+void fcpp::tools::MovieRecorder::start(const bool fromSnapshot)
+{
+    dptr->movie->clear();
+    dptr->movie->setROMHash(Movie::hash(dptr->fc->getCartridge()->getContent()));
+    if (fromSnapshot)
+    {
+        dptr->fc->save(dptr->snapshot);
+        dptr->movie->setStartSnapshot(dptr->snapshot);
+    }
+    else dptr->fc->powerOn();
+
+    dptr->frame = 0;
+    for (auto& input : dptr->input)
+    {
+        detail::latchMovieInput(input);
+        input.latched = true;
+    }
+}
+void fcpp::tools::MovieRecorder::stop() noexcept
+{
+    for (auto& input : dptr->input) input.latched = false;
+}
+bool fcpp::tools::MovieRecorder::isRecording() const noexcept
+{
+    return dptr->input[0].latched;
+}
+
+struct fcpp::tools::MoviePlayer::MoviePlayerData
+{
+    fcpp::core::FC* fc = nullptr;
+    const Movie* movie = nullptr;
+    detail::MovieInput input[2]{};
+    detail::MovieOutput output{};
+    fcpp::core::Snapshot start{};
+    std::uint32_t frame = 0;
+    std::uint32_t mismatchFrame = 0;
+    bool verify = true, completed = false, started = false;
+
+    void latch() noexcept
+    {
+        input[0].input = movie->getInput(frame, 0);
+        input[1].input = movie->getInput(frame, 1);
+    }
+
+    static void frameCompleted(void* const context)
+    {
+        auto data = static_cast<MoviePlayerData*>(context);
+        data->completed = true;
+        data->frame++;
+
+        auto interval = data->movie->getHashInterval();
+        if (data->verify && interval && data->frame % interval == 0 && !data->mismatchFrame)
+        {
+            std::size_t idx = data->frame / interval - 1;
+            if (idx < data->movie->getHashCount() && data->movie->getHash(idx) != data->fc->getStateHash())
+                data->mismatchFrame = data->frame;
+        }
+        data->latch();
+    }
+};
+
+fcpp::tools::MoviePlayer::MoviePlayer() : dptr(std::make_unique<MoviePlayerData>())
+{
+    dptr->output.callback = MoviePlayerData::frameCompleted;
+    dptr->output.context = dptr.get();
+    dptr->input[0].latched = dptr->input[1].latched = true;
+}
+fcpp::tools::MoviePlayer::~MoviePlayer() noexcept = default;
+
+void fcpp::tools::MoviePlayer::connect(fcpp::core::FC* const fc, const Movie* const movie) noexcept
+{
+    dptr->fc = fc;
+    dptr->movie = movie;
+    fc->connect(0, &dptr->input[0]);
+    fc->connect(1, &dptr->input[1]);
+    fc->connect(static_cast<fcpp::core::FrameBuffer*>(&dptr->output));
+    fc->connect(static_cast<fcpp::core::SampleBuffer*>(&dptr->output));
+    dptr->started = false;
+    rewind();
+}
+void fcpp::tools::MoviePlayer::connect(fcpp::core::FrameBuffer* const frameBuffer) noexcept
+{
+    dptr->output.frameBuffer = frameBuffer;
+    if (dptr->fc != nullptr) dptr->fc->connect(static_cast<fcpp::core::FrameBuffer*>(&dptr->output));
+}
+void fcpp::tools::MoviePlayer::connect(fcpp::core::SampleBuffer* const sampleBuffer) noexcept
+{
+    dptr->output.sampleBuffer = sampleBuffer;
+    if (dptr->fc != nullptr) dptr->fc->connect(static_cast<fcpp::core::SampleBuffer*>(&dptr->output));
+}
+void fcpp::tools::MoviePlayer::setVerify(const bool enable) noexcept
+{
+    dptr->verify = enable;
+}
+
+void fcpp::tools::MoviePlayer::rewind() noexcept
+{
+    // powering on again would not clear everything, so replay from the state captured the first time
+    if (!dptr->started)
+    {
+        if (auto snapshot = dptr->movie->getStartSnapshot(); snapshot != nullptr) dptr->start = *snapshot;
+        else
+        {
+            dptr->fc->powerOn();
+            dptr->fc->save(dptr->start);
+        }
+        dptr->started = true;
+    }
+    dptr->fc->load(dptr->start);
+
+    dptr->frame = 0;
+    dptr->mismatchFrame = 0;
+    dptr->latch();
+}
+bool fcpp::tools::MoviePlayer::play(const std::uint32_t frames) noexcept
+{
+    for (std::uint32_t i = 0; i < frames; i++)
+    {
+        if (isFinished() || dptr->mismatchFrame) return false;
+
+        dptr->completed = false;
+        while (!dptr->completed) dptr->fc->exec();
+    }
+    return !isFinished() && !dptr->mismatchFrame;
+}
+
+std::uint32_t fcpp::tools::MoviePlayer::getFrame() const noexcept
+{
+    return dptr->frame;
+}
+bool fcpp::tools::MoviePlayer::isFinished() const noexcept
+{
+    return dptr->frame >= dptr->movie->getFrameCount();
+}
+std::uint32_t fcpp::tools::MoviePlayer::getMismatchFrame() const noexcept
+{
+    return dptr->mismatchFrame;
+}
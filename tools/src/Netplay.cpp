@@ -0,0 +1,262 @@
+#include <chrono>
+
+#include "FCPP/Tools/Netplay.hpp"
+
+namespace fcpp::tools::detail
+{
+    class NetplayIO :
+        public fcpp::core::FrameBuffer,
+        public fcpp::core::SampleBuffer
+    {
+    public:
+        NetplayIO() = default;
+        ~NetplayIO() override = default;
+
+        void setPixel(int x, int y, std::uint32_t color) noexcept override;
+        void completedSignal() noexcept override;
+        const std::uint32_t* getPaletteTable() noexcept override;
+        bool keepsLastFrame() noexcept override;
+        void setFrameUnchanged(bool unchanged) noexcept override;
+
+        void sendSample(double sample) noexcept override;
+        int getSampleRate() noexcept override;
+    public:
+        fcpp::core::FrameBuffer* frameBuffer = nullptr;
+        fcpp::core::SampleBuffer* sampleBuffer = nullptr;
+        // shown: the last frame went to the frame buffer
+        bool output = true, completed = false, shown = false;
+    };
+    void NetplayIO::setPixel(const int x, const int y, const std::uint32_t color) noexcept
+    {
+        if (output && frameBuffer != nullptr) frameBuffer->setPixel(x, y, color);
+    }
+    void NetplayIO::completedSignal() noexcept
+    {
+        completed = true;
+        shown = output;
+        if (output && frameBuffer != nullptr) frameBuffer->completedSignal();
+    }
+    const std::uint32_t* NetplayIO::getPaletteTable() noexcept
+    {
+        return frameBuffer != nullptr ? frameBuffer->getPaletteTable() : nullptr;
+    }
+    bool NetplayIO::keepsLastFrame() noexcept
+    {
+        // resimulated frames are not shown, so the buffer only holds the last frame if it was shown too
+        return !output || frameBuffer == nullptr || (shown && frameBuffer->keepsLastFrame());
+    }
+    void NetplayIO::setFrameUnchanged(const bool unchanged) noexcept
+    {
+        if (output && frameBuffer != nullptr) frameBuffer->setFrameUnchanged(unchanged && shown);
+    }
+    void NetplayIO::sendSample(const double sample) noexcept
+    {
+        if (output && sampleBuffer != nullptr) sampleBuffer->sendSample(sample);
+    }
+    int NetplayIO::getSampleRate() noexcept
+    {
+        return sampleBuffer != nullptr ? sampleBuffer->getSampleRate() : 44100;
+    }
+
+    class NetplayInput : public fcpp::core::InputScanner
+    {
+    public:
+        NetplayInput() = default;
+        ~NetplayInput() override = default;
+
+        std::uint8_t scan() noexcept override;
+        fcpp::core::JoypadType getJoypadType() noexcept override;
+    public:
+        std::uint8_t input = 0;
+    };
+    std::uint8_t NetplayInput::scan() noexcept
+    {
+        return input;
+    }
+    fcpp::core::JoypadType NetplayInput::getJoypadType() noexcept
+    {
+        return fcpp::core::JoypadType::Standard;
+    }
+
+    /*
+    * Packet layout, integers are little-endian:
+    * 0-1: Constant "FN"
+    * 2-5: Last remote frame received in order (ack)
+    * 6-9: Frame of the first input
+    * 10: Input count
+    * 11-: Inputs
+    */
+    static constexpr std::size_t NetplayHeaderSize = 11;
+    static constexpr std::uint32_t NetplayRingSize = 64;
+
+    inline static void writeFrame(std::uint8_t* const data, const std::uint32_t frame) noexcept
+    {
+        for (int i = 0; i < 4; i++) data[i] = static_cast<std::uint8_t>((frame >> (8 * i)) & 0xff);
+    }
+    inline static std::uint32_t readFrame(const std::uint8_t* const data) noexcept
+    {
+        std::uint32_t frame = 0;
+        for (int i = 0; i < 4; i++) frame |= static_cast<std::uint32_t>(data[i]) << (8 * i);
+        return frame;
+    }
+}
+
+struct fcpp::tools::Netplay::NetplayData
+{
+    static constexpr std::uint32_t none = 0xffffffff;
+
+    fcpp::core::FC* fc = nullptr;
+    Transport* transport = nullptr;
+    int localPort = 0;
+
+    detail::NetplayIO io{};
+    detail::NetplayInput input[2]{};
+
+    // next frame to emulate
+    std::uint32_t frame = 0;
+    // frames [0, confirmed) have remote input
+    std::uint32_t confirmed = 0;
+    // frames [0, acked) of local input have reached the peer
+    std::uint32_t acked = 0;
+    // earliest frame emulated with a wrong prediction
+    std::uint32_t rollback = none;
+    std::uint64_t rollbackFrames = 0;
+    double maxRollbackTime = 0.0;
+
+    std::uint8_t localInput[detail::NetplayRingSize]{};
+    std::uint8_t remoteInput[detail::NetplayRingSize]{};
+    std::uint8_t predictedInput[detail::NetplayRingSize]{};
+    fcpp::core::Snapshot snapshots[MaxRollbackFrames + 1]{};
+
+    std::uint8_t remoteAt(const std::uint32_t f) const noexcept
+    {
+        if (f < confirmed) return remoteInput[f % detail::NetplayRingSize];
+        return confirmed ? remoteInput[(confirmed - 1) % detail::NetplayRingSize] : 0;
+    }
+    void step(const std::uint32_t f, const bool output) noexcept
+    {
+        auto remote = remoteAt(f);
+        predictedInput[f % detail::NetplayRingSize] = remote;
+        input[localPort].input = localInput[f % detail::NetplayRingSize];
+        input[localPort ^ 1].input = remote;
+
+        fc->save(snapshots[f % (MaxRollbackFrames + 1)]);
+        io.output = output;
+        io.completed = false;
+        while (!io.completed) fc->exec();
+    }
+    void receive() noexcept
+    {
+        std::uint8_t packet[detail::NetplayHeaderSize + detail::NetplayRingSize]{};
+        std::size_t size = 0;
+        while ((size = transport->receive(packet, sizeof(packet))) != 0)
+        {
+            if (size < detail::NetplayHeaderSize || packet[0] != 'F' || packet[1] != 'N') continue;
+            auto ack = detail::readFrame(packet + 2);
+            auto first = detail::readFrame(packet + 6);
+            std::size_t count = packet[10];
+            if (size < detail::NetplayHeaderSize + count) continue;
+
+            if (ack > acked && ack <= frame) acked = ack;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                auto f = first + static_cast<std::uint32_t>(i);
+                if (f != confirmed) continue; // out of order or already known
+                auto value = packet[detail::NetplayHeaderSize + i];
+                remoteInput[f % detail::NetplayRingSize] = value;
+                confirmed++;
+                if (f < frame && predictedInput[f % detail::NetplayRingSize] != value && f < rollback) rollback = f;
+            }
+        }
+    }
+    void send() noexcept
+    {
+        std::uint8_t packet[detail::NetplayHeaderSize + detail::NetplayRingSize]{};
+        auto first = acked;
+        auto count = frame - first;
+        packet[0] = 'F';
+        packet[1] = 'N';
+        detail::writeFrame(packet + 2, confirmed);
+        detail::writeFrame(packet + 6, first);
+        packet[10] = static_cast<std::uint8_t>(count);
+        for (std::uint32_t i = 0; i < count; i++) packet[detail::NetplayHeaderSize + i] = localInput[(first + i) % detail::NetplayRingSize];
+        transport->send(packet, detail::NetplayHeaderSize + count);
+    }
+};
+
+fcpp::tools::Netplay::Netplay() : dptr(std::make_unique<NetplayData>()) {}
+fcpp::tools::Netplay::~Netplay() noexcept = default;
+
+void fcpp::tools::Netplay::connect(fcpp::core::FC* const fc, Transport* const transport, const int localPort) noexcept
+{
+    dptr->fc = fc;
+    dptr->transport = transport;
+    dptr->localPort = localPort & 1;
+    fc->connect(0, &dptr->input[0]);
+    fc->connect(1, &dptr->input[1]);
+    fc->connect(static_cast<fcpp::core::FrameBuffer*>(&dptr->io));
+    fc->connect(static_cast<fcpp::core::SampleBuffer*>(&dptr->io));
+}
+void fcpp::tools::Netplay::connect(fcpp::core::FrameBuffer* const frameBuffer) noexcept
+{
+    dptr->io.frameBuffer = frameBuffer;
+    if (dptr->fc != nullptr) dptr->fc->connect(static_cast<fcpp::core::FrameBuffer*>(&dptr->io));
+}
+void fcpp::tools::Netplay::connect(fcpp::core::SampleBuffer* const sampleBuffer) noexcept
+{
+    dptr->io.sampleBuffer = sampleBuffer;
+    if (dptr->fc != nullptr) dptr->fc->connect(static_cast<fcpp::core::SampleBuffer*>(&dptr->io));
+}
+
+bool fcpp::tools::Netplay::exec(const std::uint8_t input) noexcept
+{
+    dptr->receive();
+
+    // too far ahead of the peer, or local input not yet acknowledged would overflow the ring
+    if (dptr->frame >= dptr->confirmed + MaxRollbackFrames ||
+        dptr->frame - dptr->acked >= detail::NetplayRingSize - 1)
+    {
+        dptr->send();
+        return false;
+    }
+
+    if (dptr->rollback != NetplayData::none)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto target = dptr->frame;
+        dptr->fc->load(dptr->snapshots[dptr->rollback % (MaxRollbackFrames + 1)]);
+        for (auto f = dptr->rollback; f < target; f++) dptr->step(f, false);
+        dptr->rollbackFrames += target - dptr->rollback;
+        dptr->rollback = NetplayData::none;
+
+        std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+        if (time.count() > dptr->maxRollbackTime) dptr->maxRollbackTime = time.count();
+    }
+
+    dptr->localInput[dptr->frame % detail::NetplayRingSize] = input;
+    dptr->step(dptr->frame++, true);
+    dptr->send();
+    return true;
+}
+void fcpp::tools::Netplay::poll() noexcept
+{
+    dptr->receive();
+    dptr->send();
+}
+
+std::uint32_t fcpp::tools::Netplay::getFrame() const noexcept
+{
+    return dptr->frame;
+}
+std::uint32_t fcpp::tools::Netplay::getConfirmedFrame() const noexcept
+{
+    return dptr->confirmed;
+}
+std::uint64_t fcpp::tools::Netplay::getRollbackFrames() const noexcept
+{
+    return dptr->rollbackFrames;
+}
+double fcpp::tools::Netplay::getMaxRollbackTime() const noexcept
+{
+    return dptr->maxRollbackTime;
+}
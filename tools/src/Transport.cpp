@@ -0,0 +1,201 @@
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#if defined(_WIN32)
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#else
+#   include <fcntl.h>
+#   include <netdb.h>
+#   include <sys/socket.h>
+#   include <unistd.h>
+#endif
+
+#include "FCPP/Tools/Transport.hpp"
+
+namespace fcpp::tools::detail
+{
+    // bounded like a socket buffer, a full channel drops the datagram instead of growing
+    class Channel
+    {
+    public:
+        static constexpr std::size_t MaxDatagrams = 64;
+        static constexpr std::size_t MaxDatagramSize = 1472;
+    public:
+        Channel() = default;
+        ~Channel() = default;
+
+        bool push(const std::uint8_t* data, std::size_t size) noexcept;
+        std::size_t pop(std::uint8_t* buffer, std::size_t capacity) noexcept;
+    private:
+        std::mutex mutex{};
+        std::size_t head = 0;
+        std::size_t count = 0;
+        std::size_t sizes[MaxDatagrams]{};
+        std::uint8_t datagrams[MaxDatagrams][MaxDatagramSize]{};
+    };
+    inline bool Channel::push(const std::uint8_t* const data, const std::size_t size) noexcept
+    {
+        if (size > MaxDatagramSize) return false;
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (count == MaxDatagrams) return false;
+        auto idx = (head + count++) % MaxDatagrams;
+        std::memcpy(datagrams[idx], data, size);
+        sizes[idx] = size;
+        return true;
+    }
+    inline std::size_t Channel::pop(std::uint8_t* const buffer, const std::size_t capacity) noexcept
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (count == 0) return 0;
+        auto size = sizes[head] < capacity ? sizes[head] : capacity; // truncated like a datagram socket
+        std::memcpy(buffer, datagrams[head], size);
+        head = (head + 1) % MaxDatagrams;
+        count--;
+        return size;
+    }
+}
+
+struct fcpp::tools::LoopbackTransport::LoopbackTransportData
+{
+    std::shared_ptr<detail::Channel> in{};
+    std::shared_ptr<detail::Channel> out{};
+};
+
+void fcpp::tools::LoopbackTransport::pair(LoopbackTransport& a, LoopbackTransport& b)
+{
+    a.dptr->in = b.dptr->out = std::make_shared<detail::Channel>();
+    a.dptr->out = b.dptr->in = std::make_shared<detail::Channel>();
+}
+
+fcpp::tools::LoopbackTransport::LoopbackTransport() : dptr(std::make_unique<LoopbackTransportData>()) {}
+fcpp::tools::LoopbackTransport::~LoopbackTransport() noexcept = default;
+
+bool fcpp::tools::LoopbackTransport::send(const std::uint8_t* const data, const std::size_t size) noexcept
+{
+    return dptr->out && dptr->out->push(data, size);
+}
+std::size_t fcpp::tools::LoopbackTransport::receive(std::uint8_t* const buffer, const std::size_t capacity) noexcept
+{
+    return dptr->in ? dptr->in->pop(buffer, capacity) : 0;
+}
+
+struct fcpp::tools::UDPTransport::UDPTransportData
+{
+#if defined(_WIN32)
+    using Socket = SOCKET;
+    static constexpr Socket invalidSocket = INVALID_SOCKET;
+    bool wsaStarted = false;
+#else
+    using Socket = int;
+    static constexpr Socket invalidSocket = -1;
+#endif
+    Socket socket = invalidSocket;
+
+    static void closeSocket(const Socket socket) noexcept
+    {
+#if defined(_WIN32)
+        closesocket(socket);
+#else
+        ::close(socket);
+#endif
+    }
+};
+
+fcpp::tools::UDPTransport::UDPTransport() : dptr(std::make_unique<UDPTransportData>()) {}
+fcpp::tools::UDPTransport::~UDPTransport() noexcept
+{
+    close();
+}
+
+bool fcpp::tools::UDPTransport::open(const std::uint16_t localPort, const char* const host, const std::uint16_t port) noexcept
+{
+    close();
+#if defined(_WIN32)
+    WSADATA wsaData{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return false;
+    dptr->wsaStarted = true;
+#endif
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* remote = nullptr;
+    if (getaddrinfo(host, std::to_string(port).c_str(), &hints, &remote) != 0 || remote == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    bool ok = false;
+    auto socket = ::socket(remote->ai_family, remote->ai_socktype, remote->ai_protocol);
+    if (socket != UDPTransportData::invalidSocket)
+    {
+        sockaddr_storage local{};
+        socklen_t localLength = 0;
+        if (remote->ai_family == AF_INET6)
+        {
+            auto addr = reinterpret_cast<sockaddr_in6*>(&local);
+            addr->sin6_family = AF_INET6;
+            addr->sin6_port = htons(localPort);
+            addr->sin6_addr = in6addr_any;
+            localLength = sizeof(sockaddr_in6);
+        }
+        else
+        {
+            auto addr = reinterpret_cast<sockaddr_in*>(&local);
+            addr->sin_family = AF_INET;
+            addr->sin_port = htons(localPort);
+            addr->sin_addr.s_addr = htonl(INADDR_ANY);
+            localLength = sizeof(sockaddr_in);
+        }
+#if defined(_WIN32)
+        u_long nonBlocking = 1;
+        bool nonBlockingSet = ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+#else
+        bool nonBlockingSet = fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+        ok = nonBlockingSet &&
+            bind(socket, reinterpret_cast<sockaddr*>(&local), localLength) == 0 &&
+            connect(socket, remote->ai_addr, static_cast<socklen_t>(remote->ai_addrlen)) == 0;
+        if (ok) dptr->socket = socket;
+        else UDPTransportData::closeSocket(socket);
+    }
+    freeaddrinfo(remote);
+
+    if (!ok) close();
+    return ok;
+}
+void fcpp::tools::UDPTransport::close() noexcept
+{
+    if (dptr->socket != UDPTransportData::invalidSocket)
+    {
+        UDPTransportData::closeSocket(dptr->socket);
+        dptr->socket = UDPTransportData::invalidSocket;
+    }
+#if defined(_WIN32)
+    if (dptr->wsaStarted)
+    {
+        WSACleanup();
+        dptr->wsaStarted = false;
+    }
+#endif
+}
+
+bool fcpp::tools::UDPTransport::send(const std::uint8_t* const data, const std::size_t size) noexcept
+{
+    if (dptr->socket == UDPTransportData::invalidSocket) return false;
+    return ::send(dptr->socket, reinterpret_cast<const char*>(data), static_cast<int>(size), 0) == static_cast<int>(size);
+}
+std::size_t fcpp::tools::UDPTransport::receive(std::uint8_t* const buffer, const std::size_t capacity) noexcept
+{
+    if (dptr->socket == UDPTransportData::invalidSocket) return 0;
+    auto size = recv(dptr->socket, reinterpret_cast<char*>(buffer), static_cast<int>(capacity), 0);
+    return size > 0 ? static_cast<std::size_t>(size) : 0;
+}
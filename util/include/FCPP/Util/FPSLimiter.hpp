@@ -1,8 +1,19 @@
 #ifndef FCPP_UTIL_FPS_LIMITER_HPP
 #define FCPP_UTIL_FPS_LIMITER_HPP
 
-#include <thread>
+#include <cmath>
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+
+#include "FCPP/Util/Trace.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#endif
 
 namespace fcpp::util
 {
@@ -10,8 +21,25 @@ namespace fcpp::util
     class AdaptiveFPSLimiter;
 }
 
+/*
+* Sleeps until absolute deadlines spaced by the frame time, so oversleeping one frame is made up by the next ones.
+* When more than a frame behind, e.g. after a pause, the schedule restarts from now instead of running a burst.
+*/
 class fcpp::util::FPSLimiter
 {
+public:
+    // in milliseconds
+    struct Stats
+    {
+        std::uint64_t frames = 0;
+        // frames that had to restart the schedule
+        std::uint64_t missed = 0;
+        double meanFrameTime = 0.0;
+        // standard deviation of the frame time
+        double jitter = 0.0;
+        // worst wake up delay after a deadline
+        double maxLateness = 0.0;
+    };
 public:
     explicit FPSLimiter(double fps = 60.0) noexcept;
     FPSLimiter(const FPSLimiter&) = delete;
@@ -20,32 +48,118 @@ public:
 
     void wait() noexcept;
     void set(double fps) noexcept;
+    // pace from the fill level of an audio buffer in [0, 1] by stretching the frame time slightly, nullptr to disable
+    void setAudioClock(std::function<double()> fillLevel) noexcept;
+    Stats getStats() const noexcept;
+    void resetStats() noexcept;
 protected:
+    static void sleepUntil(std::chrono::steady_clock::time_point time) noexcept;
+    void record(std::chrono::steady_clock::time_point now, double lateness) noexcept;
+protected:
+    // the audio clock may change the frame time by this ratio at most, which is not audible
+    static constexpr double maxRateDelta = 0.005;
+
     double frameTime;
-    std::chrono::steady_clock::time_point frameStartTime;
+    double sleepTime = 0.0;
+    std::chrono::steady_clock::time_point deadline;
+    std::function<double()> audioFillLevel{};
+
+    std::chrono::steady_clock::time_point lastFrameTime;
+    std::uint64_t frameCount = 0, missedCount = 0;
+    double frameTimeSum = 0.0, frameTimeSquareSum = 0.0, maxLateness = 0.0;
 };
 
 inline fcpp::util::FPSLimiter::FPSLimiter(const double fps) noexcept :
     frameTime(1000.0 / (fps < 1.0 ? 1.0 : (500.0 < fps ? 500.0 : fps))),
-    frameStartTime(std::chrono::steady_clock::now()) {}
+    deadline(std::chrono::steady_clock::now()), lastFrameTime(deadline) {}
 
 inline void fcpp::util::FPSLimiter::wait() noexcept
 {
+    Trace::Scope scope{ "limiter wait" };
+    auto now = std::chrono::steady_clock::now();
+    double lateness = 0.0;
     if (frameTime > 2.0)
     {
-        const auto&& frameEndTime = frameStartTime + std::chrono::duration<double, std::milli>{frameTime};
-        const auto&& scheduleTime = frameStartTime + std::chrono::duration<double, std::milli>{frameTime - 2.0};
-        if (std::chrono::steady_clock::now() < scheduleTime) std::this_thread::sleep_until(scheduleTime);
-        while (std::chrono::steady_clock::now() < frameEndTime) std::this_thread::yield();
-        frameStartTime = std::chrono::steady_clock::now();
+        double scale = 1.0;
+        if (audioFillLevel)
+        {
+            double fill = audioFillLevel();
+            scale += maxRateDelta * (2.0 * (fill < 0.0 ? 0.0 : (1.0 < fill ? 1.0 : fill)) - 1.0);
+        }
+        deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>{ frameTime * scale });
+
+        if (deadline + std::chrono::duration<double, std::milli>{ frameTime } < now)
+        {
+            deadline = now;
+            missedCount++;
+        }
+        else if (now < deadline)
+        {
+            sleepUntil(deadline);
+            auto wake = std::chrono::steady_clock::now();
+            sleepTime += std::chrono::duration<double, std::milli>{ wake - now }.count();
+            lateness = std::chrono::duration<double, std::milli>{ wake - deadline }.count();
+            now = wake;
+        }
     }
+    record(now, lateness);
 }
 inline void fcpp::util::FPSLimiter::set(const double fps) noexcept
 {
     frameTime = 1000.0 / (fps < 1.0 ? 1.0 : (500.0 < fps ? 500.0 : fps));
 }
+inline void fcpp::util::FPSLimiter::setAudioClock(std::function<double()> fillLevel) noexcept
+{
+    audioFillLevel = std::move(fillLevel);
+}
+inline fcpp::util::FPSLimiter::Stats fcpp::util::FPSLimiter::getStats() const noexcept
+{
+    Stats stats{};
+    stats.frames = frameCount;
+    stats.missed = missedCount;
+    stats.maxLateness = maxLateness;
+    if (frameCount)
+    {
+        stats.meanFrameTime = frameTimeSum / frameCount;
+        double variance = frameTimeSquareSum / frameCount - stats.meanFrameTime * stats.meanFrameTime;
+        stats.jitter = variance > 0.0 ? std::sqrt(variance) : 0.0;
+    }
+    return stats;
+}
+inline void fcpp::util::FPSLimiter::resetStats() noexcept
+{
+    frameCount = missedCount = 0;
+    frameTimeSum = frameTimeSquareSum = maxLateness = 0.0;
+    lastFrameTime = std::chrono::steady_clock::now();
+}
+inline void fcpp::util::FPSLimiter::sleepUntil(const std::chrono::steady_clock::time_point time) noexcept
+{
+#ifdef __linux__
+    // steady_clock is CLOCK_MONOTONIC on linux
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    timespec ts{};
+    ts.tv_sec = static_cast<std::time_t>(ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR);
+#else
+    std::this_thread::sleep_until(time);
+#endif
+}
+inline void fcpp::util::FPSLimiter::record(const std::chrono::steady_clock::time_point now, const double lateness) noexcept
+{
+    double elapsed = std::chrono::duration<double, std::milli>{ now - lastFrameTime }.count();
+    lastFrameTime = now;
+    frameCount++;
+    frameTimeSum += elapsed;
+    frameTimeSquareSum += elapsed * elapsed;
+    if (maxLateness < lateness) maxLateness = lateness;
+}
 
 
+/*
+* Limits only when the frames would otherwise be too fast, so it does not add to the pacing of vsync.
+* The decision is revisited every checkInterval frames, with an audio clock it always limits.
+*/
 class fcpp::util::AdaptiveFPSLimiter : public fcpp::util::FPSLimiter
 {
 public:
@@ -58,35 +172,52 @@ public:
     void set(double fps) noexcept;
 private:
     static constexpr double increment = 5.0;
+    static constexpr int checkInterval = 120;
+    // limiting is dropped when it sleeps less than this per frame, something else is pacing then
+    static constexpr double minSleepTime = 0.5;
 
     bool enableFlag;
-    int frameCount;
-    double frameRate, frameRateThreshold;
-    std::chrono::steady_clock::time_point keyFrameStartTime;
+    int checkCount;
+    double frameRateThreshold;
+    std::chrono::steady_clock::time_point checkStartTime;
 };
 
 inline fcpp::util::AdaptiveFPSLimiter::AdaptiveFPSLimiter(const double fps) noexcept :
     FPSLimiter(fps),
-    enableFlag(false), frameCount(0), frameRate(0.0), frameRateThreshold(fps + increment),
-    keyFrameStartTime(std::chrono::steady_clock::now()) {}
+    enableFlag(false), checkCount(0), frameRateThreshold(fps + increment),
+    checkStartTime(std::chrono::steady_clock::now()) {}
 
 inline void fcpp::util::AdaptiveFPSLimiter::wait() noexcept
 {
-    if (!enableFlag && ++frameCount == 120)
+    if (enableFlag || audioFillLevel) FPSLimiter::wait();
+    else record(std::chrono::steady_clock::now(), 0.0);
+
+    if (++checkCount == checkInterval)
     {
-        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - keyFrameStartTime;
-        frameRate = 1000.0 * frameCount / elapsed.count();
-        if (frameRate > frameRateThreshold) enableFlag = true;
-        frameCount = 0;
-        keyFrameStartTime = std::chrono::steady_clock::now();
+        auto now = std::chrono::steady_clock::now();
+        if (enableFlag) enableFlag = sleepTime / checkCount > minSleepTime;
+        else
+        {
+            std::chrono::duration<double, std::milli> elapsed = now - checkStartTime;
+            if (1000.0 * checkCount / elapsed.count() > frameRateThreshold)
+            {
+                enableFlag = true;
+                deadline = now;
+            }
+        }
+        checkCount = 0;
+        sleepTime = 0.0;
+        checkStartTime = now;
     }
-    if (enableFlag) FPSLimiter::wait();
 }
 inline void fcpp::util::AdaptiveFPSLimiter::set(const double fps) noexcept
 {
     FPSLimiter::set(fps);
     frameRateThreshold = fps + increment;
     enableFlag = false;
+    checkCount = 0;
+    sleepTime = 0.0;
+    checkStartTime = std::chrono::steady_clock::now();
 }
 
 #endif
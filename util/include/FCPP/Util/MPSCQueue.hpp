@@ -0,0 +1,84 @@
+#ifndef FCPP_UTIL_MPSC_QUEUE_HPP
+#define FCPP_UTIL_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+namespace fcpp::util
+{
+    template<typename T>
+    class MPSCQueue;
+}
+
+/*
+* Lock-free multiple producer single consumer queue, one node per element.
+* Any thread may push, only one thread may pop, check for empty or clear.
+* A push still in progress may be seen as empty, the element will be popped by a later call.
+*/
+template<typename T>
+class fcpp::util::MPSCQueue
+{
+public:
+    MPSCQueue();
+    MPSCQueue(const MPSCQueue&) = delete;
+    ~MPSCQueue();
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    void push(T value);
+
+    // consumer side
+    bool pop(T& value);
+    // a single relaxed load, call pop() to synchronize with the producers
+    bool empty() const noexcept;
+    void clear();
+private:
+    struct Node
+    {
+        std::atomic<Node*> next{ nullptr };
+        T value{};
+    };
+private:
+    std::atomic<Node*> head;
+    Node* tail;
+};
+
+template<typename T>
+inline fcpp::util::MPSCQueue<T>::MPSCQueue() : head(new Node{}), tail(head.load(std::memory_order_relaxed)) {}
+template<typename T>
+inline fcpp::util::MPSCQueue<T>::~MPSCQueue()
+{
+    clear();
+    delete tail;
+}
+
+template<typename T>
+inline void fcpp::util::MPSCQueue<T>::push(T value)
+{
+    auto node = new Node{};
+    node->value = std::move(value);
+    head.exchange(node, std::memory_order_acq_rel)->next.store(node, std::memory_order_release);
+}
+template<typename T>
+inline bool fcpp::util::MPSCQueue<T>::pop(T& value)
+{
+    auto next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) return false;
+    // the popped node becomes the new dummy
+    value = std::move(next->value);
+    next->value = T{};
+    delete tail;
+    tail = next;
+    return true;
+}
+template<typename T>
+inline bool fcpp::util::MPSCQueue<T>::empty() const noexcept
+{
+    return tail->next.load(std::memory_order_relaxed) == nullptr;
+}
+template<typename T>
+inline void fcpp::util::MPSCQueue<T>::clear()
+{
+    for (T value{}; pop(value););
+}
+
+#endif
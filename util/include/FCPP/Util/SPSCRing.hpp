@@ -0,0 +1,69 @@
+#ifndef FCPP_UTIL_SPSC_RING_HPP
+#define FCPP_UTIL_SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace fcpp::util
+{
+    template<typename T, std::size_t N>
+    class SPSCRing;
+}
+
+/*
+* Lock-free single producer single consumer ring of N preallocated slots.
+* The producer fills back() in place and pushes it, the consumer reads front() in place and pops it,
+* slots are reused as they are, so a slot may hold whatever the consumer left in it.
+*/
+template<typename T, std::size_t N>
+class fcpp::util::SPSCRing
+{
+public:
+    SPSCRing() = default;
+    SPSCRing(const SPSCRing&) = delete;
+    ~SPSCRing() = default;
+    SPSCRing& operator=(const SPSCRing&) = delete;
+
+    // producer side, back() is nullptr if the ring is full
+    T* back() noexcept;
+    void push() noexcept;
+
+    // consumer side, front() is nullptr if the ring is empty
+    T* front() noexcept;
+    void pop() noexcept;
+private:
+    // one slot stays empty to tell a full ring from an empty one
+    static constexpr std::size_t Size = N + 1;
+
+    const std::unique_ptr<T[]> slots{ new T[Size]{} };
+    alignas(64) std::atomic<std::size_t> head{ 0 };
+    alignas(64) std::atomic<std::size_t> tail{ 0 };
+};
+
+template<typename T, std::size_t N>
+inline T* fcpp::util::SPSCRing<T, N>::back() noexcept
+{
+    auto idx = tail.load(std::memory_order_relaxed);
+    if ((idx + 1) % Size == head.load(std::memory_order_acquire)) return nullptr;
+    return &slots[idx];
+}
+template<typename T, std::size_t N>
+inline void fcpp::util::SPSCRing<T, N>::push() noexcept
+{
+    tail.store((tail.load(std::memory_order_relaxed) + 1) % Size, std::memory_order_release);
+}
+template<typename T, std::size_t N>
+inline T* fcpp::util::SPSCRing<T, N>::front() noexcept
+{
+    auto idx = head.load(std::memory_order_relaxed);
+    if (idx == tail.load(std::memory_order_acquire)) return nullptr;
+    return &slots[idx];
+}
+template<typename T, std::size_t N>
+inline void fcpp::util::SPSCRing<T, N>::pop() noexcept
+{
+    head.store((head.load(std::memory_order_relaxed) + 1) % Size, std::memory_order_release);
+}
+
+#endif
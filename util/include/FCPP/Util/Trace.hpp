@@ -0,0 +1,135 @@
+#ifndef FCPP_UTIL_TRACE_HPP
+#define FCPP_UTIL_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <FCPPUTILExport.hpp>
+
+namespace fcpp::util
+{
+    class Trace;
+}
+
+/*
+* Timeline of named events per thread, dumped as Chrome trace JSON for chrome://tracing or Perfetto.
+* Each thread records to its own lock-free ring buffer keeping the latest Capacity events,
+* a lock is only taken the first time a thread records and by dump().
+* Nothing is recorded until enabled, names must outlive the dump, string literals are expected.
+*/
+class fcpp::util::Trace
+{
+public:
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name) noexcept;
+        Scope(const Scope&) = delete;
+        ~Scope() noexcept;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        const char* name;
+    };
+public:
+    static constexpr std::size_t Capacity = 1 << 15;
+public:
+    FCPP_UTIL_EXPORT static void enable(bool enable) noexcept;
+    static bool enabled() noexcept;
+    static void begin(const char* name) noexcept;
+    static void end(const char* name) noexcept;
+    static void instant(const char* name) noexcept;
+    // name of the calling thread in the timeline
+    static void setThreadName(const char* name) noexcept;
+    // may run while other threads record, events overwritten during the dump are left out
+    FCPP_UTIL_EXPORT static bool dump(const char* path);
+private:
+    enum class Phase : std::uint64_t
+    {
+        Begin, End, Instant
+    };
+    // the phase is kept in the low bits of the time stamp so an event is two atomic words
+    struct Event
+    {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<std::uint64_t> stamp{ 0 };
+    };
+    struct Buffer
+    {
+        std::atomic<bool> owned{ true };
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<std::uint64_t> size{ 0 };
+        Event events[Capacity]{};
+    };
+    struct Registry
+    {
+        std::atomic<bool> enabled{ false };
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        std::mutex mutex{};
+        std::vector<std::unique_ptr<Buffer>> buffers{};
+    };
+    // releases the buffer for reuse when its thread exits, the events stay for the dump
+    struct Local
+    {
+        Buffer* buffer = nullptr;
+        const char* name = nullptr;
+        ~Local() noexcept;
+    };
+private:
+    static void record(const char* name, Phase phase) noexcept;
+    // defined once in the library, so every module records to the same registry and thread buffers
+    FCPP_UTIL_EXPORT static Registry& registry() noexcept;
+    FCPP_UTIL_EXPORT static Local& local() noexcept;
+    FCPP_UTIL_EXPORT static Buffer& acquire() noexcept;
+};
+
+inline fcpp::util::Trace::Scope::Scope(const char* const name) noexcept : name(name)
+{
+    begin(name);
+}
+inline fcpp::util::Trace::Scope::~Scope() noexcept
+{
+    end(name);
+}
+
+inline bool fcpp::util::Trace::enabled() noexcept
+{
+    return registry().enabled.load(std::memory_order_relaxed);
+}
+inline void fcpp::util::Trace::begin(const char* const name) noexcept
+{
+    record(name, Phase::Begin);
+}
+inline void fcpp::util::Trace::end(const char* const name) noexcept
+{
+    record(name, Phase::End);
+}
+inline void fcpp::util::Trace::instant(const char* const name) noexcept
+{
+    record(name, Phase::Instant);
+}
+inline void fcpp::util::Trace::setThreadName(const char* const name) noexcept
+{
+    auto& state = local();
+    state.name = name;
+    if (state.buffer != nullptr) state.buffer->name.store(name, std::memory_order_relaxed);
+}
+inline void fcpp::util::Trace::record(const char* const name, const Phase phase) noexcept
+{
+    auto& state = registry();
+    if (!state.enabled.load(std::memory_order_relaxed)) return;
+
+    auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - state.epoch).count();
+    auto& buffer = acquire();
+    auto idx = buffer.size.load(std::memory_order_relaxed);
+    auto& event = buffer.events[idx % Capacity];
+    event.name.store(name, std::memory_order_relaxed);
+    event.stamp.store(static_cast<std::uint64_t>(time) << 2 | static_cast<std::uint64_t>(phase), std::memory_order_relaxed);
+    buffer.size.store(idx + 1, std::memory_order_release);
+}
+
+#endif
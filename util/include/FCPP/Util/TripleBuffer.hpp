@@ -0,0 +1,73 @@
+#ifndef FCPP_UTIL_TRIPLE_BUFFER_HPP
+#define FCPP_UTIL_TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+namespace fcpp::util
+{
+    template<typename T>
+    class TripleBuffer;
+}
+
+/*
+* Lock-free single producer single consumer triple buffer.
+* The writer fills back() and publishes it, the reader takes the latest published buffer with update(),
+* buffers published before the reader catches up are dropped.
+*/
+template<typename T>
+class fcpp::util::TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    ~TripleBuffer() = default;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // writer side
+    T& back() noexcept;
+    // the last published buffer, read only and valid until the next publish
+    const T& last() const noexcept;
+    void publish() noexcept;
+
+    // reader side, false if nothing new has been published
+    bool update() noexcept;
+    const T& front() const noexcept;
+private:
+    static constexpr unsigned int IndexMask = 0x03;
+    static constexpr unsigned int FreshFlag = 0x04;
+
+    T buffers[3]{};
+    unsigned int backIdx = 0, lastIdx = 0, frontIdx = 2;
+    std::atomic<unsigned int> middle{ 1 };
+};
+
+template<typename T>
+inline T& fcpp::util::TripleBuffer<T>::back() noexcept
+{
+    return buffers[backIdx];
+}
+template<typename T>
+inline const T& fcpp::util::TripleBuffer<T>::last() const noexcept
+{
+    return buffers[lastIdx];
+}
+template<typename T>
+inline void fcpp::util::TripleBuffer<T>::publish() noexcept
+{
+    lastIdx = backIdx;
+    backIdx = middle.exchange(backIdx | FreshFlag, std::memory_order_acq_rel) & IndexMask;
+}
+template<typename T>
+inline bool fcpp::util::TripleBuffer<T>::update() noexcept
+{
+    if (!(middle.load(std::memory_order_relaxed) & FreshFlag)) return false;
+    frontIdx = middle.exchange(frontIdx, std::memory_order_acq_rel) & IndexMask;
+    return true;
+}
+template<typename T>
+inline const T& fcpp::util::TripleBuffer<T>::front() const noexcept
+{
+    return buffers[frontIdx];
+}
+
+#endif
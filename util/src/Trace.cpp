@@ -0,0 +1,110 @@
+#include <fstream>
+#include <utility>
+
+#include "FCPP/Util/Trace.hpp"
+
+void fcpp::util::Trace::enable(const bool enable) noexcept
+{
+    registry().enabled.store(enable, std::memory_order_relaxed);
+}
+bool fcpp::util::Trace::dump(const char* const path)
+{
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    auto writeString = [&](const char* text) {
+        file << '"';
+        for (; *text; text++)
+        {
+            if (*text == '"' || *text == '\\') file << '\\';
+            file << *text;
+        }
+        file << '"';
+    };
+
+    auto& state = registry();
+    std::lock_guard lock{ state.mutex };
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::vector<std::pair<const char*, std::uint64_t>> events{};
+    for (std::size_t tid = 0; tid < state.buffers.size(); tid++)
+    {
+        auto& buffer = *state.buffers[tid];
+        if (auto name = buffer.name.load(std::memory_order_relaxed); name != nullptr)
+        {
+            file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":";
+            writeString(name);
+            file << "}}";
+            first = false;
+        }
+
+        // copy first, a slot the owner has started to overwrite since is dropped
+        auto size = buffer.size.load(std::memory_order_acquire);
+        auto start = size > Capacity ? size - Capacity : 0;
+        events.clear();
+        for (auto i = start; i < size; i++)
+        {
+            auto& event = buffer.events[i % Capacity];
+            events.emplace_back(event.name.load(std::memory_order_relaxed), event.stamp.load(std::memory_order_relaxed));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto current = buffer.size.load(std::memory_order_relaxed);
+        auto valid = current + 1 > Capacity ? current + 1 - Capacity : 0;
+
+        for (auto i = start < valid ? valid : start; i < size; i++)
+        {
+            auto [name, stamp] = events[i - start];
+            if (name == nullptr) continue;
+            auto phase = static_cast<Phase>(stamp & 0x03);
+            file << (first ? "" : ",") << "\n{\"name\":";
+            writeString(name);
+            file << ",\"ph\":\"" << (phase == Phase::Begin ? "B" : (phase == Phase::End ? "E" : "i")) << '"'
+                << (phase == Phase::Instant ? ",\"s\":\"t\"" : "")
+                << ",\"ts\":" << (stamp >> 2) / 1000 << '.' << static_cast<char>('0' + (stamp >> 2) % 1000 / 100)
+                << ",\"pid\":1,\"tid\":" << tid << '}';
+            first = false;
+        }
+    }
+    file << "\n]}\n";
+    return file.good();
+}
+fcpp::util::Trace::Registry& fcpp::util::Trace::registry() noexcept
+{
+    // never destroyed, threads such as the audio callback may still record during exit
+    static auto state = new Registry{};
+    return *state;
+}
+fcpp::util::Trace::Local& fcpp::util::Trace::local() noexcept
+{
+    thread_local Local state{};
+    return state;
+}
+fcpp::util::Trace::Buffer& fcpp::util::Trace::acquire() noexcept
+{
+    auto& current = local();
+    if (current.buffer != nullptr) return *current.buffer;
+
+    // buffers of exited threads are reused, so a new thread per game does not grow the memory
+    auto& state = registry();
+    std::lock_guard lock{ state.mutex };
+    for (auto&& buffer : state.buffers)
+    {
+        bool owned = false;
+        if (buffer->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+        {
+            current.buffer = buffer.get();
+            break;
+        }
+    }
+    if (current.buffer == nullptr)
+    {
+        state.buffers.push_back(std::make_unique<Buffer>());
+        current.buffer = state.buffers.back().get();
+    }
+    current.buffer->name.store(current.name, std::memory_order_relaxed);
+    return *current.buffer;
+}
+fcpp::util::Trace::Local::~Local() noexcept
+{
+    if (buffer != nullptr) buffer->owned.store(false, std::memory_order_release);
+}